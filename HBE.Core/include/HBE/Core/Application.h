@@ -1,6 +1,7 @@
 #pragma once
 
 #include "HBE/Core/LayerStack.h"
+#include "HBE/Core/JobSystem.h"
 
 #include "HBE/Platform/SDLPlatform.h"
 #include "HBE/Platform/Audio.h"
@@ -38,6 +39,16 @@ namespace HBE::Core {
 		void pushLayer(std::unique_ptr<Layer> layer);
 		void pushOverlay(std::unique_ptr<Layer> overlay);
 
+		// Fixed-rate simulation: Layer::onFixedUpdate runs at 'hz' (0 disables it), at most
+		// maxStepsPerFrame times per frame; time beyond that budget is dropped so a slow
+		// frame can't snowball into slower ones.
+		void setFixedUpdateRate(float hz, int maxStepsPerFrame = 5);
+		float fixedDeltaTime() const { return m_fixedDt; }
+		// how far the current frame is between the last fixed step and the next one (0..1);
+		// blend previous -> current simulation state by this when rendering
+		float fixedAlpha() const { return m_fixedAlpha; }
+		int fixedStepsLastFrame() const { return m_fixedStepsLastFrame; }
+
 		// Logical render size for letterboxing
 		void setLogicalSize(int w, int h) { m_logicalW = w; m_logicalH = h; recalcViewportAndNotify(); }
 
@@ -47,6 +58,7 @@ namespace HBE::Core {
 		HBE::Renderer::GLRenderer& gl() { return m_gl; }
 		HBE::Renderer::Renderer2D& renderer2D() { return m_renderer2D; }
 		HBE::Renderer::ResourceCache& resources() { return m_resources; }
+		JobSystem& jobs() { return m_jobs; }
 
 		int windowWidthPixels() const { return m_winW; }
 		int windowHeightPixels() const { return m_winH; }
@@ -72,6 +84,16 @@ namespace HBE::Core {
 
 		LayerStack m_layers;
 
+		// worker pool for any subsystem (also reachable via JobSystem::Get())
+		JobSystem m_jobs;
+
+		// fixed-rate simulation
+		float m_fixedDt = 1.0f / 60.0f; // 0 = disabled
+		int m_maxFixedSteps = 5;
+		double m_fixedAccumulator = 0.0;
+		float m_fixedAlpha = 1.0f;
+		int m_fixedStepsLastFrame = 0;
+
 		int m_winW = 0;
 		int m_winH = 0;
 
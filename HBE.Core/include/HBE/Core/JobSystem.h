@@ -0,0 +1,111 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace HBE::Core {
+
+	// Completion counter for one or more jobs. Copyable; all copies share the counter.
+	class JobHandle {
+	public:
+		JobHandle() = default;
+
+		bool valid() const { return static_cast<bool>(m_counter); }
+		bool done() const { return !m_counter || m_counter->load(std::memory_order_acquire) == 0; }
+
+	private:
+		std::shared_ptr<std::atomic<int>> m_counter;
+
+		friend class JobSystem;
+	};
+
+	// Worker pool with one deque per worker and work stealing.
+	// - Workers pop their own newest job first and steal the oldest job from others.
+	// - wait() runs other jobs while the handle is pending, so jobs may wait on jobs.
+	// - Main-thread jobs (GL calls, anything tied to the window) are queued separately
+	//   and run by runMainThreadJobs(), which Application::run calls once per frame.
+	// Application starts it in initialize() and stops it on shutdown; subsystems reach
+	// it through JobSystem::Get() (null when not running, callers then run inline).
+	class JobSystem {
+	public:
+		using JobFn = std::function<void()>;
+
+		JobSystem() = default;
+		~JobSystem();
+
+		JobSystem(const JobSystem&) = delete;
+		JobSystem& operator=(const JobSystem&) = delete;
+
+		// workerCount 0 = one per hardware thread minus the main thread
+		bool start(unsigned workerCount = 0);
+
+		// finishes queued jobs, then joins the workers
+		void shutdown();
+
+		bool running() const { return m_running.load(std::memory_order_acquire); }
+		unsigned workerCount() const { return static_cast<unsigned>(m_workers.size()); }
+
+		// Queue a job for any worker. The overload taking a handle adds the job
+		// to that handle's counter (wait once for a batch). Runs inline if not started.
+		JobHandle schedule(JobFn fn);
+		void schedule(JobFn fn, JobHandle& handle);
+
+		// Block until the handle's jobs finished, running queued jobs meanwhile.
+		void wait(const JobHandle& handle);
+
+		// fn(begin, end) over [0, count) in chunks of at least minChunk indices.
+		// The calling thread takes part; returns when every chunk is done.
+		void parallelFor(std::size_t count, std::size_t minChunk, const std::function<void(std::size_t, std::size_t)>& fn);
+
+		// Runs on the main thread during runMainThreadJobs() (next frame at the latest).
+		// Don't wait() on these handles from the main thread itself.
+		JobHandle scheduleMainThread(JobFn fn);
+		void runMainThreadJobs();
+
+		bool isMainThread() const { return std::this_thread::get_id() == m_mainThread; }
+
+		// -1 on threads that aren't workers of this system
+		int currentWorkerIndex() const;
+
+		// running instance (set by start(), cleared by shutdown())
+		static JobSystem* Get();
+
+	private:
+		struct Job {
+			JobFn fn;
+			std::shared_ptr<std::atomic<int>> counter;
+		};
+
+		struct WorkerQueue {
+			std::mutex mutex;
+			std::deque<Job> jobs;
+		};
+
+		std::vector<std::thread> m_workers;
+		std::vector<std::unique_ptr<WorkerQueue>> m_queues;
+
+		std::atomic<bool> m_running{ false };
+		std::atomic<unsigned> m_nextQueue{ 0 };
+		std::atomic<int> m_queued{ 0 };
+
+		std::mutex m_sleepMutex;
+		std::condition_variable m_wake;
+
+		std::mutex m_mainMutex;
+		std::vector<Job> m_mainJobs;
+		std::thread::id m_mainThread{};
+
+		void push(Job job);
+		bool tryRunOne(int selfIndex);
+		static void execute(Job& job);
+		void workerLoop(int index);
+	};
+
+}
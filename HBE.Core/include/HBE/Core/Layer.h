@@ -12,6 +12,12 @@ namespace HBE::Core {
 		virtual void onAttach(Application& app) {}
 		virtual void onDetach() {}
 
+		// Fixed-rate simulation step (see Application::setFixedUpdateRate).
+		// Runs zero or more times per frame, before onUpdate. Edge-triggered input
+		// ("pressed this frame") should be latched in onUpdate: frames without a step would drop it.
+		virtual void onFixedUpdate(float fixedDt) {}
+
+		// Once per frame with the real (clamped) frame time.
 		virtual void onUpdate(float dt) {}
 		virtual void onRender() {}
 
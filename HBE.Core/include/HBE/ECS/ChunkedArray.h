@@ -0,0 +1,116 @@
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <utility>
+#include <vector>
+#include <cassert>
+
+namespace HBE::ECS {
+
+    // ----------------------------
+    // ChunkedArray
+    // vector-like container made of fixed-size blocks.
+    // Growing allocates a new block; existing elements are never moved or
+    // copied, so references stay valid until the element itself is removed.
+    // Elements are contiguous within a block.
+    // ----------------------------
+    template<typename T, std::size_t BlockSize>
+    class ChunkedArray {
+    public:
+        static_assert(BlockSize > 0 && (BlockSize & (BlockSize - 1)) == 0, "ChunkedArray BlockSize must be a power of two");
+
+        ChunkedArray() = default;
+        ~ChunkedArray() { clear(); }
+
+        ChunkedArray(const ChunkedArray&) = delete;
+        ChunkedArray& operator=(const ChunkedArray&) = delete;
+
+        ChunkedArray(ChunkedArray&& other) noexcept
+            : m_blocks(std::move(other.m_blocks)), m_size(other.m_size) {
+            other.m_size = 0;
+        }
+
+        ChunkedArray& operator=(ChunkedArray&& other) noexcept {
+            if (this != &other) {
+                clear();
+                m_blocks = std::move(other.m_blocks);
+                m_size = other.m_size;
+                other.m_size = 0;
+            }
+            return *this;
+        }
+
+        std::size_t size() const { return m_size; }
+        bool empty() const { return m_size == 0; }
+        std::size_t capacity() const { return m_blocks.size() * BlockSize; }
+
+        static constexpr std::size_t blockSize() { return BlockSize; }
+        std::size_t blockCount() const { return m_blocks.size(); }
+
+        // first element of block b (elements [b * BlockSize, b * BlockSize + BlockSize) are contiguous)
+        T* blockData(std::size_t b) { return m_blocks[b]->ptr(0); }
+        const T* blockData(std::size_t b) const { return m_blocks[b]->ptr(0); }
+
+        T& operator[](std::size_t i) {
+            assert(i < m_size);
+            return *m_blocks[i / BlockSize]->ptr(i & (BlockSize - 1));
+        }
+
+        const T& operator[](std::size_t i) const {
+            assert(i < m_size);
+            return *m_blocks[i / BlockSize]->ptr(i & (BlockSize - 1));
+        }
+
+        T& back() { return (*this)[m_size - 1]; }
+        const T& back() const { return (*this)[m_size - 1]; }
+
+        void reserve(std::size_t n) {
+            while (capacity() < n) {
+                m_blocks.push_back(std::unique_ptr<Block>(new Block)); // uninitialized bytes
+            }
+        }
+
+        template<typename... Args>
+        T& emplace_back(Args&&... args) {
+            reserve(m_size + 1);
+            T* slot = m_blocks[m_size / BlockSize]->ptr(m_size & (BlockSize - 1));
+            ::new (static_cast<void*>(slot)) T(std::forward<Args>(args)...);
+            ++m_size;
+            return *slot;
+        }
+
+        void push_back(const T& v) { emplace_back(v); }
+        void push_back(T&& v) { emplace_back(std::move(v)); }
+
+        void pop_back() {
+            assert(m_size > 0);
+            --m_size;
+            m_blocks[m_size / BlockSize]->ptr(m_size & (BlockSize - 1))->~T();
+        }
+
+        // destroys elements, keeps blocks allocated
+        void clear() {
+            while (m_size > 0) pop_back();
+        }
+
+        // frees blocks past the ones in use
+        void shrink_to_fit() {
+            const std::size_t needed = (m_size + BlockSize - 1) / BlockSize;
+            m_blocks.resize(needed);
+        }
+
+    private:
+        struct Block {
+            alignas(T) unsigned char bytes[sizeof(T) * BlockSize];
+
+            T* ptr(std::size_t i) { return reinterpret_cast<T*>(bytes) + i; }
+            const T* ptr(std::size_t i) const { return reinterpret_cast<const T*>(bytes) + i; }
+        };
+
+        std::vector<std::unique_ptr<Block>> m_blocks;
+        std::size_t m_size = 0;
+    };
+
+}
@@ -0,0 +1,128 @@
+#pragma once
+
+#include "HBE/ECS/Registry.h"
+
+#include <cstdint>
+#include <functional>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace HBE::ECS {
+
+    // ----------------------------
+    // CommandBuffer
+    // Records structural changes (create/destroy/emplace/remove) instead of
+    // applying them, so systems can request them while iterating a view.
+    // flush() applies everything in recording order at a system boundary.
+    //
+    // A buffer never touches the registry until flush(), so each worker thread
+    // can record into its own buffer; flush the buffers on one thread.
+    // ----------------------------
+    class CommandBuffer {
+    public:
+        // high bit marks a provisional handle returned by create()
+        static constexpr Entity PendingBit = 0x80000000u;
+
+        static bool isPending(Entity e) { return (e & PendingBit) != 0; }
+
+        // Returns a provisional handle usable with this buffer's emplace/remove/destroy.
+        // It turns into a real entity during flush().
+        Entity create() {
+            return PendingBit | m_pendingCreates++;
+        }
+
+        void destroy(Entity e) {
+            m_commands.push_back({ e, [](Registry& reg, Entity target) { reg.destroy(target); } });
+        }
+
+        template<typename T, typename... Args>
+        void emplace(Entity e, Args&&... args) {
+            countEmplace<T>();
+            m_commands.push_back({ e, [value = T(std::forward<Args>(args)...)](Registry& reg, Entity target) mutable {
+                reg.emplace<T>(target, std::move(value));
+                } });
+        }
+
+        template<typename T>
+        void remove(Entity e) {
+            m_commands.push_back({ e, [](Registry& reg, Entity target) { reg.remove<T>(target); } });
+        }
+
+        bool empty() const { return m_commands.empty() && m_pendingCreates == 0; }
+        std::size_t commandCount() const { return m_commands.size(); }
+        std::uint32_t pendingCreates() const { return m_pendingCreates; }
+
+        // Apply all recorded commands, then reset the buffer.
+        // Entities and storages are reserved up front so the batch doesn't reallocate mid-way.
+        // Commands that target an entity destroyed earlier in the batch are skipped.
+        void flush(Registry& reg) {
+            if (empty()) return;
+
+            reg.reserveEntities(m_pendingCreates);
+            m_created.clear();
+            m_created.reserve(m_pendingCreates);
+            for (std::uint32_t i = 0; i < m_pendingCreates; ++i) {
+                m_created.push_back(reg.create());
+            }
+
+            for (const TypeCount& tc : m_typeCounts) {
+                tc.reserve(reg, tc.count);
+            }
+
+            for (Command& cmd : m_commands) {
+                const Entity target = isPending(cmd.entity) ? m_created[cmd.entity & ~PendingBit] : cmd.entity;
+                if (!reg.valid(target)) continue;
+                cmd.apply(reg, target);
+            }
+
+            clear();
+        }
+
+        // drop everything recorded so far (provisional handles become meaningless)
+        void clear() {
+            m_commands.clear();
+            m_typeCounts.clear();
+            m_pendingCreates = 0;
+        }
+
+        // real entities produced by the last flush(), indexed by creation order
+        const std::vector<Entity>& lastCreated() const { return m_created; }
+
+    private:
+        struct Command {
+            Entity entity = Null;
+            std::function<void(Registry&, Entity)> apply;
+        };
+
+        // emplace count per component type, used to reserve storages before applying
+        struct TypeCount {
+            ComponentTypeID type = 0;
+            std::size_t count = 0;
+            void (*reserve)(Registry&, std::size_t) = nullptr;
+        };
+
+        std::vector<Command> m_commands;
+        std::vector<TypeCount> m_typeCounts;
+        std::vector<Entity> m_created;
+        std::uint32_t m_pendingCreates = 0;
+
+        template<typename T>
+        void countEmplace() {
+            const ComponentTypeID type = ComponentType<T>();
+            for (TypeCount& tc : m_typeCounts) {
+                if (tc.type == type) { ++tc.count; return; }
+            }
+
+            TypeCount tc;
+            tc.type = type;
+            tc.count = 1;
+            tc.reserve = [](Registry& reg, std::size_t n) {
+                const auto* st = reg.tryStorage<T>();
+                reg.reserve<T>((st ? st->size() : 0) + n);
+                };
+            m_typeCounts.push_back(tc);
+        }
+    };
+
+}
@@ -0,0 +1,84 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+namespace HBE::ECS {
+
+    // Upper bound on distinct component types per process (see ComponentType<T>()).
+    inline constexpr std::size_t MaxComponentTypes = 128;
+
+    // Fixed-size bitset of component type IDs (one bit per component an entity owns).
+    struct ComponentMask {
+        static constexpr std::size_t WordCount = (MaxComponentTypes + 63) / 64;
+
+        std::uint64_t words[WordCount] = {};
+
+        void set(std::size_t id) { words[id >> 6] |= (std::uint64_t(1) << (id & 63)); }
+        void reset(std::size_t id) { words[id >> 6] &= ~(std::uint64_t(1) << (id & 63)); }
+        bool test(std::size_t id) const { return (words[id >> 6] >> (id & 63)) & 1u; }
+
+        void clear() {
+            for (auto& w : words) w = 0;
+        }
+
+        bool none() const {
+            for (auto w : words) if (w) return false;
+            return true;
+        }
+
+        // true if every bit set in 'required' is also set here
+        bool containsAll(const ComponentMask& required) const {
+            for (std::size_t i = 0; i < WordCount; ++i) {
+                if ((words[i] & required.words[i]) != required.words[i]) return false;
+            }
+            return true;
+        }
+
+        // true if at least one bit is set in both
+        bool intersects(const ComponentMask& other) const {
+            for (std::size_t i = 0; i < WordCount; ++i) {
+                if (words[i] & other.words[i]) return true;
+            }
+            return false;
+        }
+
+        void merge(const ComponentMask& other) {
+            for (std::size_t i = 0; i < WordCount; ++i) words[i] |= other.words[i];
+        }
+
+        // calls func(id) for each set bit, lowest first
+        template<typename Func>
+        void forEach(Func&& func) const {
+            for (std::size_t i = 0; i < WordCount; ++i) {
+                std::uint64_t w = words[i];
+                while (w) {
+                    func(i * 64 + lowestBit(w));
+                    w &= w - 1;
+                }
+            }
+        }
+
+    private:
+        static std::size_t lowestBit(std::uint64_t w) {
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_ARM64))
+            unsigned long idx = 0;
+            _BitScanForward64(&idx, w);
+            return static_cast<std::size_t>(idx);
+#elif defined(_MSC_VER)
+            // 32-bit targets (x86) have no 64-bit scan; w is never zero here
+            unsigned long idx = 0;
+            if (_BitScanForward(&idx, static_cast<unsigned long>(w))) return static_cast<std::size_t>(idx);
+            _BitScanForward(&idx, static_cast<unsigned long>(w >> 32));
+            return static_cast<std::size_t>(idx) + 32;
+#else
+            return static_cast<std::size_t>(__builtin_ctzll(w));
+#endif
+        }
+    };
+
+}
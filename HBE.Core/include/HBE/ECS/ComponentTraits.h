@@ -0,0 +1,28 @@
+#pragma once
+
+#include <cstddef>
+
+namespace HBE::ECS {
+
+    // Per-component storage options.
+    // Specialize for a component type to opt it into a different layout:
+    //
+    //   template<> struct HBE::ECS::ComponentTraits<MyHeavyComponent> {
+    //       static constexpr bool stableStorage = true;
+    //       static constexpr std::size_t blockSize = 128;
+    //   };
+    template<typename T>
+    struct ComponentTraits {
+        // false: components live in one std::vector (fastest iteration, moves on growth).
+        // true:  components live in fixed-size blocks that are never reallocated,
+        //        so growing the storage never moves existing components and T*
+        //        stays valid across spawns. Removing a *different* entity still
+        //        swap-moves the last component into the hole (sparse-set removal),
+        //        and an owning group over T reorders components as well.
+        static constexpr bool stableStorage = false;
+
+        // components per block when stableStorage is set (power of two)
+        static constexpr std::size_t blockSize = 256;
+    };
+
+}
@@ -3,6 +3,7 @@
 
 #include <functional>
 #include <string>
+#include <vector>
 
 namespace HBE::ECS {
 
@@ -27,8 +28,19 @@ namespace HBE::ECS {
 		float accelY = 0.0f;
 		float linearDamping = 0.0f;
 
+		// changing this on a live body: write it through Registry::patch<RigidBody2D>()
 		bool isStatic = false;
 
+		// Dynamic-vs-dynamic pushes are split by inverse mass; 0 = can't be pushed by other bodies
+		float mass = 1.0f;
+
+		// Sleeping (see Physics2DSettings::sleeping): a body that stayed slow for a while stops
+		// being simulated until it is touched, patched, given velocity/acceleration or a
+		// touching body wakes. Scene2D manages 'sleeping' and 'stillFrames'.
+		bool canSleep = true;
+		bool sleeping = false;
+		int stillFrames = 0;
+
 		// --- Platformer helpers (optional) ---
 		bool useGravity = false;
 		float gravityScale = 1.0f;
@@ -45,6 +57,16 @@ namespace HBE::ECS {
 		float maxFallSpeed = 0.0f;
 	};
 
+	// Transform hierarchy (see Scene2D::setParent).
+	// The child's Transform2D is relative to the parent; Scene2D keeps both sides in sync.
+	struct Parent {
+		Entity entity = Null;
+	};
+
+	struct Children {
+		std::vector<Entity> entities;
+	};
+
 	// script hook
 	struct Script {
 		std::string name;
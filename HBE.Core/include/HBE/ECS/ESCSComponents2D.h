@@ -7,6 +7,7 @@ namespace HBE::Renderer {
 }
 
 #include "HBE/Renderer/SpriteAnimationStateMachine.h"
+#include "HBE/ECS/ComponentTraits.h"
 
 namespace HBE::Renderer {
 
@@ -30,4 +31,16 @@ namespace HBE::Renderer {
         SpriteAnimationStateMachine sm;
     };
 
-} // namespace HBE::Renderer
\ No newline at end of file
+} // namespace HBE::Renderer
+
+namespace HBE::ECS {
+
+    // State machines are heavy (maps + strings) and handed out as raw pointers by
+    // Scene2D::addSpriteAnimator, so keep them in blocks that never move on growth.
+    template<>
+    struct ComponentTraits<HBE::Renderer::AnimationComponent2D> {
+        static constexpr bool stableStorage = true;
+        static constexpr std::size_t blockSize = 64;
+    };
+
+}
\ No newline at end of file
@@ -0,0 +1,140 @@
+#pragma once
+
+#include "HBE/ECS/Registry.h"
+
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace HBE::ECS {
+
+    // ----------------------------
+    // Prefab
+    // A component set plus default values, instantiated in bulk:
+    //   Prefab goblin("Goblin");
+    //   goblin.set<Collider2D>({ 20.0f, 28.0f });
+    //   reg.instantiate(goblin, 10000, spawned);
+    // Every instance gets a copy of each default; tweak per-instance fields afterwards.
+    // ----------------------------
+    class Prefab {
+    public:
+        Prefab() = default;
+        explicit Prefab(std::string name) : m_name(std::move(name)) {}
+
+        Prefab(Prefab&&) = default;
+        Prefab& operator=(Prefab&&) = default;
+
+        const std::string& name() const { return m_name; }
+        void setName(std::string name) { m_name = std::move(name); }
+
+        // add T (or replace its default value)
+        template<typename T>
+        T& set(T value = T{}) {
+            if (T* existing = find<T>()) {
+                *existing = std::move(value);
+                return *existing;
+            }
+
+            auto bp = std::make_unique<Blueprint<T>>(std::move(value));
+            T& ref = bp->value;
+            m_components.push_back(std::move(bp));
+            m_mask.set(ComponentType<T>());
+            return ref;
+        }
+
+        template<typename T>
+        bool has() const { return m_mask.test(ComponentType<T>()); }
+
+        template<typename T>
+        T* find() {
+            const ComponentTypeID type = ComponentType<T>();
+            for (auto& bp : m_components) {
+                if (bp->type == type) return &static_cast<Blueprint<T>*>(bp.get())->value;
+            }
+            return nullptr;
+        }
+
+        const ComponentMask& mask() const { return m_mask; }
+        std::size_t componentCount() const { return m_components.size(); }
+        bool empty() const { return m_components.empty(); }
+
+    private:
+        struct IBlueprint {
+            ComponentTypeID type = 0;
+            virtual ~IBlueprint() = default;
+
+            // append a copy of the default to each of the n (new) entities
+            virtual void emplaceAll(Registry& reg, const Entity* entities, std::size_t n) const = 0;
+        };
+
+        template<typename T>
+        struct Blueprint final : IBlueprint {
+            T value;
+
+            explicit Blueprint(T v) : value(std::move(v)) { type = ComponentType<T>(); }
+
+            void emplaceAll(Registry& reg, const Entity* entities, std::size_t n) const override {
+                reg.getOrCreateStorage<T>()->emplaceCopies(entities, n, value, reg.currentTick());
+            }
+        };
+
+        std::string m_name;
+        std::vector<std::unique_ptr<IBlueprint>> m_components;
+        ComponentMask m_mask;
+
+        friend class Registry;
+    };
+
+    inline void Registry::instantiate(const Prefab& prefab, std::size_t count, std::vector<Entity>& out) {
+        if (count == 0) return;
+
+        const std::size_t first = out.size();
+        out.resize(first + count);
+        Entity* entities = out.data() + first;
+
+        // recycled IDs first (same order as create()), then one resize for the rest
+        std::size_t i = 0;
+        for (; i < count && !m_free.empty(); ++i) {
+            entities[i] = m_free.back();
+            m_free.pop_back();
+            m_alive[entities[i]] = true;
+        }
+
+        Entity next = static_cast<Entity>(m_alive.size());
+        const std::size_t fresh = count - i;
+        m_alive.resize(m_alive.size() + fresh, true);
+        m_signatures.resize(m_signatures.size() + fresh);
+        for (; i < count; ++i) {
+            entities[i] = next++;
+        }
+
+        for (i = 0; i < count; ++i) {
+            m_signatures[entities[i]] = prefab.m_mask;
+        }
+
+        for (const auto& bp : prefab.m_components) {
+            bp->emplaceAll(*this, entities, count);
+        }
+
+        // groups pack once every component is in place; each owning group visited once
+        std::vector<IGroupHandler*> owners;
+        prefab.m_mask.forEach([&](ComponentTypeID id) {
+            IGroupHandler* owner = m_storages[id]->owner;
+            if (owner && std::find(owners.begin(), owners.end(), owner) == owners.end()) {
+                owners.push_back(owner);
+            }
+            });
+
+        for (IGroupHandler* owner : owners) {
+            for (i = 0; i < count; ++i) owner->onConstruct(entities[i]);
+        }
+
+        prefab.m_mask.forEach([&](ComponentTypeID id) {
+            const IStorage* s = m_storages[id].get();
+            if (s->constructed.empty()) return;
+            for (std::size_t k = 0; k < count; ++k) s->constructed.publish(*this, entities[k]);
+            });
+    }
+
+}
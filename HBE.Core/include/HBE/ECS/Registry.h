@@ -1,16 +1,213 @@
 #pragma once
 
 #include "HBE/ECS/Entity.h"
+#include "HBE/ECS/ComponentTraits.h"
+#include "HBE/ECS/ChunkedArray.h"
+#include "HBE/ECS/ComponentMask.h"
+#include "HBE/Core/JobSystem.h"
 
 #include <vector>
 #include <memory>
-#include <typeindex>
-#include <unordered_map>
+#include <tuple>
+#include <type_traits>
+#include <atomic>
+#include <functional>
 #include <utility>
+#include <limits>
+#include <algorithm>
+#include <cstring>
+#include <typeinfo>
 #include <cassert>
 
 namespace HBE::ECS {
 
+    // ----------------------------
+    // Component type IDs
+    // Dense per-process IDs handed out on first use of each type.
+    // Storages are indexed by these, so a lookup is a single vector load.
+    // ----------------------------
+    using ComponentTypeID = std::size_t;
+
+    namespace detail {
+        inline ComponentTypeID NextComponentTypeID() {
+            static std::atomic<ComponentTypeID> s_counter{ 0 };
+            return s_counter.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+
+    template<typename T>
+    inline ComponentTypeID ComponentType() {
+        static const ComponentTypeID id = detail::NextComponentTypeID();
+        assert(id < MaxComponentTypes && "Too many component types; raise MaxComponentTypes");
+        return id;
+    }
+
+    // ----------------------------
+    // Group handler (owning group bookkeeping)
+    // ----------------------------
+    struct IGroupHandler {
+        virtual ~IGroupHandler() = default;
+
+        // called after a component owned by the group was added to e
+        virtual void onConstruct(Entity e) = 0;
+
+        // called before a component owned by the group is removed from e
+        virtual void onDestroy(Entity e) = 0;
+
+        // number of packed entities (used by snapshot/restore)
+        virtual std::size_t packedSize() const = 0;
+        virtual void setPackedSize(std::size_t size) = 0;
+
+        // re-partition from scratch (storage order changed behind the group's back)
+        virtual void rebuild() = 0;
+    };
+
+    // ----------------------------
+    // Paged sparse array: entity -> dense index (or -1)
+    // Pages are allocated only where entities exist and released once empty,
+    // so memory follows the component count instead of the highest entity ID.
+    // ----------------------------
+    class SparseArray {
+    public:
+        static constexpr std::size_t PageSize = 4096; // entries per page (power of two)
+
+        int get(Entity e) const {
+            const std::size_t page = e / PageSize;
+            if (page >= m_pages.size() || !m_pages[page]) return -1;
+            return m_pages[page][e & (PageSize - 1)];
+        }
+
+        // entity must already have a slot (set() was called for it)
+        void update(Entity e, int index) {
+            m_pages[e / PageSize][e & (PageSize - 1)] = index;
+        }
+
+        void set(Entity e, int index) {
+            const std::size_t page = e / PageSize;
+            if (page >= m_pages.size()) {
+                m_pages.resize(page + 1);
+                m_used.resize(page + 1, 0);
+            }
+
+            if (!m_pages[page]) {
+                m_pages[page] = std::make_unique<int[]>(PageSize);
+                std::fill_n(m_pages[page].get(), PageSize, -1);
+            }
+
+            int& slot = m_pages[page][e & (PageSize - 1)];
+            if (slot < 0) ++m_used[page];
+            slot = index;
+        }
+
+        void reset(Entity e) {
+            const std::size_t page = e / PageSize;
+            if (page >= m_pages.size() || !m_pages[page]) return;
+
+            int& slot = m_pages[page][e & (PageSize - 1)];
+            if (slot < 0) return;
+            slot = -1;
+
+            if (--m_used[page] == 0) m_pages[page].reset();
+        }
+
+        std::size_t pageCount() const {
+            std::size_t n = 0;
+            for (const auto& p : m_pages) if (p) ++n;
+            return n;
+        }
+
+        std::size_t memoryBytes() const {
+            return pageCount() * PageSize * sizeof(int)
+                + m_pages.capacity() * sizeof(std::unique_ptr<int[]>)
+                + m_used.capacity() * sizeof(std::uint32_t);
+        }
+
+    private:
+        std::vector<std::unique_ptr<int[]>> m_pages;
+        std::vector<std::uint32_t> m_used; // live slots per page
+    };
+
+    struct StorageMemoryStats {
+        ComponentTypeID type = 0;
+        const char* typeName = "";
+
+        std::size_t count = 0;        // components stored
+        std::size_t denseBytes = 0;   // entity list
+        std::size_t dataBytes = 0;    // component payload (capacity)
+        std::size_t sparseBytes = 0;  // sparse pages + page table
+        std::size_t sparsePages = 0;
+
+        std::size_t totalBytes() const { return denseBytes + dataBytes + sparseBytes; }
+    };
+
+    // One storage's state inside a RegistrySnapshot.
+    // Buffers are reused between captures, so a ring of snapshots stops allocating
+    // once every frame slot has seen the largest registry.
+    // Move-only: 'objects' can't be deep-copied without the component type, and a
+    // shared copy would be overwritten by the next capture into either snapshot.
+    struct StorageSnapshot {
+        StorageSnapshot() = default;
+        StorageSnapshot(const StorageSnapshot&) = delete;
+        StorageSnapshot& operator=(const StorageSnapshot&) = delete;
+        StorageSnapshot(StorageSnapshot&&) noexcept = default;
+        StorageSnapshot& operator=(StorageSnapshot&&) noexcept = default;
+
+        bool present = false;
+
+        std::vector<Entity> dense;
+        std::vector<std::uint32_t> changed;
+
+        // trivially copyable components: raw bytes, memcpy in/out
+        std::vector<unsigned char> bytes;
+
+        // everything else: std::vector<T> of clones (see Registry::setCloneHook)
+        std::shared_ptr<void> objects;
+
+        std::size_t payloadBytes = 0;
+
+        template<typename T>
+        std::vector<T>& objectsAs() {
+            if (!objects) objects = std::make_shared<std::vector<T>>();
+            return *static_cast<std::vector<T>*>(objects.get());
+        }
+
+        template<typename T>
+        const std::vector<T>& objectsAs() const {
+            return *static_cast<const std::vector<T>*>(objects.get());
+        }
+
+        std::size_t byteSize() const {
+            return dense.size() * sizeof(Entity) + changed.size() * sizeof(std::uint32_t) + payloadBytes;
+        }
+    };
+
+    class Registry;
+
+    // Observer callback: (registry, entity). Fired after construct/update and before destroy.
+    using ObserverFn = std::function<void(Registry&, Entity)>;
+
+    struct ObserverHandle {
+        ComponentTypeID type = 0;
+        std::uint32_t id = 0; // 0 = not connected
+    };
+
+    struct Signal {
+        std::vector<std::pair<std::uint32_t, ObserverFn>> slots;
+
+        bool empty() const { return slots.empty(); }
+
+        void publish(Registry& reg, Entity e) const {
+            for (const auto& s : slots) s.second(reg, e);
+        }
+
+        bool disconnect(std::uint32_t id) {
+            for (auto it = slots.begin(); it != slots.end(); ++it) {
+                if (it->first == id) { slots.erase(it); return true; }
+            }
+            return false;
+        }
+    };
+
     // ----------------------------
     // Storage (sparse-set)
     // ----------------------------
@@ -19,34 +216,70 @@ namespace HBE::ECS {
         virtual void onEntityDestroyed(Entity e) = 0;
         virtual bool has(Entity e) const = 0;
         virtual std::size_t size() const = 0;
+        virtual void reserve(std::size_t capacity) = 0;
+        virtual StorageMemoryStats memoryStats() const = 0;
+
+        // group that keeps this storage's dense array partitioned (not owned, may be null)
+        IGroupHandler* owner = nullptr;
+
+        // observers (see Registry::onConstruct/onUpdate/onDestroy)
+        Signal constructed;
+        Signal updated;
+        Signal destroyed;
+
+        // Bumped on every construct/update/remove; compare against a cached
+        // value to know whether anything in this storage changed.
+        std::uint64_t version() const { return m_version; }
+
+        // registry tick at which the entity's component was last constructed/patched
+        virtual std::uint32_t changedTick(Entity e) const = 0;
+        virtual void setChangedTick(Entity e, std::uint32_t tick) = 0;
+
+        // copy the whole storage into / back from a snapshot (no observers fire)
+        virtual void saveState(StorageSnapshot& out) const = 0;
+        virtual void loadState(const StorageSnapshot& in) = 0;
+
+    protected:
+        std::uint64_t m_version = 0;
     };
 
     template<typename T>
     class Storage final : public IStorage {
     public:
+        // std::vector by default; fixed-size blocks when ComponentTraits<T>::stableStorage is set
+        using DataArray = std::conditional_t<ComponentTraits<T>::stableStorage,
+            ChunkedArray<T, ComponentTraits<T>::blockSize>,
+            std::vector<T>>;
+
         bool has(Entity e) const override {
             if (e == Null) return false;
-            const std::uint32_t id = e;
-            if (id >= m_sparse.size()) return false;
-            const int denseIndex = m_sparse[id];
+            const int denseIndex = m_sparse.get(e);
             if (denseIndex < 0) return false;
             return static_cast<std::size_t>(denseIndex) < m_dense.size() && m_dense[denseIndex] == e;
         }
 
         std::size_t size() const override { return m_dense.size(); }
 
+        void reserve(std::size_t capacity) override {
+            m_dense.reserve(capacity);
+            m_data.reserve(capacity);
+            m_changed.reserve(capacity);
+        }
+
         T& get(Entity e) {
             assert(has(e) && "Storage<T>::get called but entity doesn't have component");
-            return m_data[m_sparse[e]];
+            return m_data[m_sparse.get(e)];
         }
 
         const T& get(Entity e) const {
             assert(has(e) && "Storage<T>::get const called but entity doesn't have component");
-            return m_data[m_sparse[e]];
+            return m_data[m_sparse.get(e)];
         }
 
         template<typename... Args>
         T& emplace(Entity e, Args&&... args) {
+            ++m_version;
+
             if (has(e)) {
                 // overwrite existing
                 T& ref = get(e);
@@ -54,46 +287,195 @@ namespace HBE::ECS {
                 return ref;
             }
 
-            const std::uint32_t id = e;
-            if (id >= m_sparse.size()) m_sparse.resize(id + 1, -1);
-
             const int index = static_cast<int>(m_dense.size());
-            m_sparse[id] = index;
+            m_sparse.set(e, index);
             m_dense.push_back(e);
+            m_changed.push_back(0);
             m_data.emplace_back(std::forward<Args>(args)...);
             return m_data.back();
         }
 
+        // append 'value' for n entities that don't have T yet (one reserve, one fill)
+        void emplaceCopies(const Entity* entities, std::size_t n, const T& value, std::uint32_t tick) {
+            const std::size_t first = m_dense.size();
+            reserve(first + n);
+
+            for (std::size_t i = 0; i < n; ++i) {
+                assert(!has(entities[i]) && "Storage<T>::emplaceCopies on an entity that already has T");
+                m_sparse.set(entities[i], static_cast<int>(first + i));
+            }
+
+            m_dense.insert(m_dense.end(), entities, entities + n);
+            m_changed.insert(m_changed.end(), n, tick);
+            if constexpr (ComponentTraits<T>::stableStorage) {
+                for (std::size_t i = 0; i < n; ++i) m_data.emplace_back(value);
+            }
+            else {
+                m_data.insert(m_data.end(), n, value);
+            }
+            ++m_version;
+        }
+
         void remove(Entity e) {
             if (!has(e)) return;
 
-            const int idx = m_sparse[e];
+            const int idx = m_sparse.get(e);
             const int last = static_cast<int>(m_dense.size() - 1);
 
             if (idx != last) {
                 // swap-remove
                 m_dense[idx] = m_dense[last];
                 m_data[idx] = std::move(m_data[last]);
-                m_sparse[m_dense[idx]] = idx;
+                m_changed[idx] = m_changed[last];
+                m_sparse.update(m_dense[idx], idx);
             }
 
             m_dense.pop_back();
             m_data.pop_back();
-            m_sparse[e] = -1;
+            m_changed.pop_back();
+            m_sparse.reset(e);
+            ++m_version;
         }
 
         const std::vector<Entity>& denseEntities() const { return m_dense; }
 
+        // dense index of an entity that has this component
+        std::size_t indexOf(Entity e) const {
+            assert(has(e) && "Storage<T>::indexOf called but entity doesn't have component");
+            return static_cast<std::size_t>(m_sparse.get(e));
+        }
+
+        T& dataAt(std::size_t index) { return m_data[index]; }
+        const T& dataAt(std::size_t index) const { return m_data[index]; }
+
+        // swap two dense slots (entity + component), keeping sparse in sync
+        void swapDense(std::size_t a, std::size_t b) {
+            if (a == b) return;
+
+            std::swap(m_dense[a], m_dense[b]);
+            std::swap(m_data[a], m_data[b]);
+            std::swap(m_changed[a], m_changed[b]);
+            m_sparse.update(m_dense[a], static_cast<int>(a));
+            m_sparse.update(m_dense[b], static_cast<int>(b));
+        }
+
         void onEntityDestroyed(Entity e) override {
             remove(e);
         }
 
+        std::uint32_t changedTick(Entity e) const override {
+            return has(e) ? m_changed[m_sparse.get(e)] : 0;
+        }
+
+        void setChangedTick(Entity e, std::uint32_t tick) override {
+            if (!has(e)) return;
+            m_changed[m_sparse.get(e)] = tick;
+            ++m_version;
+        }
+
+        std::uint32_t changedTickAt(std::size_t index) const { return m_changed[index]; }
+
+        void setCloneHook(std::function<T(const T&)> clone) { m_clone = std::move(clone); }
+
+        void saveState(StorageSnapshot& out) const override {
+            const std::size_t n = m_dense.size();
+            out.present = true;
+            out.dense.assign(m_dense.begin(), m_dense.end());
+            out.changed.assign(m_changed.begin(), m_changed.end());
+            out.payloadBytes = n * sizeof(T);
+
+            if constexpr (std::is_trivially_copyable_v<T>) {
+                out.bytes.resize(n * sizeof(T));
+                if constexpr (ComponentTraits<T>::stableStorage) {
+                    // one memcpy per block
+                    constexpr std::size_t B = ComponentTraits<T>::blockSize;
+                    for (std::size_t first = 0; first < n; first += B) {
+                        const std::size_t count = std::min(B, n - first);
+                        std::memcpy(out.bytes.data() + first * sizeof(T), m_data.blockData(first / B), count * sizeof(T));
+                    }
+                }
+                else if (n > 0) {
+                    std::memcpy(out.bytes.data(), m_data.data(), n * sizeof(T));
+                }
+            }
+            else {
+                auto& objects = out.objectsAs<T>();
+                objects.clear();
+                objects.reserve(n);
+                for (std::size_t i = 0; i < n; ++i) {
+                    objects.push_back(cloneOf(m_data[i]));
+                }
+            }
+        }
+
+        void loadState(const StorageSnapshot& in) override {
+            const std::size_t n = in.dense.size();
+
+            // point snapshot entities at their slots, then drop the ones the snapshot doesn't have
+            // (an entity not in the snapshot still maps to its old slot, which holds someone else there)
+            for (std::size_t i = 0; i < n; ++i) {
+                m_sparse.set(in.dense[i], static_cast<int>(i));
+            }
+            for (Entity e : m_dense) {
+                const int idx = m_sparse.get(e);
+                if (idx < 0 || static_cast<std::size_t>(idx) >= n || in.dense[idx] != e) m_sparse.reset(e);
+            }
+
+            m_dense.assign(in.dense.begin(), in.dense.end());
+            m_changed.assign(in.changed.begin(), in.changed.end());
+
+            m_data.clear();
+            m_data.reserve(n);
+            if constexpr (std::is_trivially_copyable_v<T>) {
+                const T* src = reinterpret_cast<const T*>(in.bytes.data());
+                if constexpr (ComponentTraits<T>::stableStorage) {
+                    for (std::size_t i = 0; i < n; ++i) m_data.emplace_back(src[i]);
+                }
+                else {
+                    m_data.assign(src, src + n);
+                }
+            }
+            else if (n > 0) {
+                for (const T& v : in.objectsAs<T>()) m_data.push_back(cloneOf(v));
+            }
+
+            ++m_version;
+        }
+
+        StorageMemoryStats memoryStats() const override {
+            StorageMemoryStats st;
+            st.type = ComponentType<T>();
+            st.typeName = typeid(T).name();
+            st.count = m_dense.size();
+            st.denseBytes = m_dense.capacity() * sizeof(Entity) + m_changed.capacity() * sizeof(std::uint32_t);
+            st.dataBytes = m_data.capacity() * sizeof(T);
+            st.sparseBytes = m_sparse.memoryBytes();
+            st.sparsePages = m_sparse.pageCount();
+            return st;
+        }
+
     private:
         std::vector<Entity> m_dense;
-        std::vector<T>      m_data;
+        DataArray           m_data;
+
+        // per dense slot: tick of last construct/patch (parallel to m_dense)
+        std::vector<std::uint32_t> m_changed;
 
         // sparse[entity] -> dense index (or -1)
-        std::vector<int>    m_sparse;
+        SparseArray         m_sparse;
+
+        // snapshot copy for components that aren't trivially copyable (optional)
+        std::function<T(const T&)> m_clone;
+
+        T cloneOf(const T& v) const {
+            if constexpr (std::is_copy_constructible_v<T>) {
+                return m_clone ? m_clone(v) : T(v);
+            }
+            else {
+                assert(m_clone && "Snapshot of a non-copyable component needs Registry::setCloneHook");
+                return m_clone(v);
+            }
+        }
     };
 
     // ----------------------------
@@ -120,6 +502,38 @@ namespace HBE::ECS {
         Iterator begin();
         Iterator end();
 
+        // Range yielding std::tuple<Entity, Components&...>:
+        //   for (auto [e, tr, rb] : reg.view<Transform2D, RigidBody2D>().each()) { ... }
+        struct EachIterator {
+            Iterator it;
+
+            std::tuple<Entity, Components&...> operator*() const;
+            EachIterator& operator++() { ++it; return *this; }
+            bool operator!=(const EachIterator& rhs) const { return it != rhs.it; }
+        };
+
+        // holds a copy of the view so reg.view<...>().each() is safe in a range-for
+        struct EachRange {
+            View view;
+            EachIterator begin() { return EachIterator{ view.begin() }; }
+            EachIterator end() { return EachIterator{ view.end() }; }
+        };
+
+        EachRange each() { return EachRange{ *this }; }
+
+        // func(Entity, Components&...) or func(Components&...).
+        // Storages are fetched once per view; the driver's components are read by dense index.
+        // Don't add/remove Components... while iterating (record into a CommandBuffer instead).
+        template<typename Func>
+        void each(Func&& func);
+
+        // Like each(), but splits the driver's dense range into chunks of at least
+        // minChunk entities and runs them on the job system (inline if none is running).
+        // func must be safe to call concurrently for different entities and must not
+        // change registry structure.
+        template<typename Func>
+        void parallelEach(Func&& func, std::size_t minChunk = 1024);
+
     private:
         Registry& m_reg;
 
@@ -127,8 +541,141 @@ namespace HBE::ECS {
         IStorage* m_driver = nullptr;
         const std::vector<Entity>* m_driverDense = nullptr;
 
+        // bits of Components..., tested against each entity's signature
+        ComponentMask m_mask{};
+
+        // fetched once in initDriver (null if the registry never stored that type)
+        std::tuple<Storage<Components>*...> m_storages{};
+        bool m_complete = false; // every storage exists
+
         void initDriver();
         bool matchesAll(Entity e) const;
+
+        template<typename C>
+        C& fetch(Entity e, std::size_t driverIndex) const;
+
+        template<typename Func>
+        void eachRange(Func& func, std::size_t begin, std::size_t end);
+    };
+
+    // ----------------------------
+    // Owning group
+    // Keeps the dense arrays of Owned... partitioned so that entities having
+    // all of them sit in [0, size) at the same index in every storage.
+    // Iterating a group is a linear walk with no membership tests.
+    // ----------------------------
+    template<typename... Owned>
+    class GroupHandler final : public IGroupHandler {
+    public:
+        static_assert(sizeof...(Owned) > 0, "GroupHandler needs at least one owned component");
+
+        explicit GroupHandler(Storage<Owned>*... storages) : m_storages(storages...) {}
+
+        std::size_t size() const { return m_size; }
+
+        bool contains(Entity e) const {
+            const auto* lead = std::get<0>(m_storages);
+            return lead->has(e) && lead->indexOf(e) < m_size;
+        }
+
+        void onConstruct(Entity e) override {
+            if (!(std::get<Storage<Owned>*>(m_storages)->has(e) && ...)) return;
+            if (std::get<0>(m_storages)->indexOf(e) < m_size) return; // already packed
+
+            (std::get<Storage<Owned>*>(m_storages)->swapDense(
+                std::get<Storage<Owned>*>(m_storages)->indexOf(e), m_size), ...);
+            ++m_size;
+        }
+
+        void onDestroy(Entity e) override {
+            if (!contains(e)) return;
+
+            --m_size;
+            (std::get<Storage<Owned>*>(m_storages)->swapDense(
+                std::get<Storage<Owned>*>(m_storages)->indexOf(e), m_size), ...);
+        }
+
+        std::size_t packedSize() const override { return m_size; }
+        void setPackedSize(std::size_t size) override { m_size = size; }
+
+        void rebuild() override {
+            m_size = 0;
+            const std::vector<Entity> entities = std::get<0>(m_storages)->denseEntities();
+            for (Entity e : entities) onConstruct(e);
+        }
+
+        const std::tuple<Storage<Owned>*...>& storages() const { return m_storages; }
+
+    private:
+        std::tuple<Storage<Owned>*...> m_storages;
+        std::size_t m_size = 0;
+    };
+
+    // Lightweight handle returned by Registry::group<Owned...>().
+    // Cheap to copy; fetch it again after the registry is replaced.
+    // Adding/removing owned components while iterating is not allowed.
+    template<typename... Owned>
+    class Group {
+    public:
+        using Lead = std::tuple_element_t<0, std::tuple<Owned...>>;
+
+        explicit Group(GroupHandler<Owned...>* handler) : m_handler(handler) {}
+
+        std::size_t size() const { return m_handler->size(); }
+        bool empty() const { return m_handler->size() == 0; }
+        bool contains(Entity e) const { return m_handler->contains(e); }
+
+        // entities in group order
+        const Entity* begin() const { return lead()->denseEntities().data(); }
+        const Entity* end() const { return begin() + size(); }
+
+        Entity entityAt(std::size_t index) const { return begin()[index]; }
+
+        template<typename T>
+        T& getAt(std::size_t index) const { return std::get<Storage<T>*>(m_handler->storages())->dataAt(index); }
+
+        // func(Entity, Owned&...)
+        template<typename Func>
+        void each(Func&& func) const {
+            const auto& st = m_handler->storages();
+            const Entity* ents = begin();
+            const std::size_t n = size();
+
+            for (std::size_t i = 0; i < n; ++i) {
+                func(ents[i], std::get<Storage<Owned>*>(st)->dataAt(i)...);
+            }
+        }
+
+    private:
+        GroupHandler<Owned...>* m_handler = nullptr;
+
+        Storage<Lead>* lead() const { return std::get<0>(m_handler->storages()); }
+    };
+
+    class Prefab;
+
+    // Full copy of a registry's entities and components (see Registry::saveSnapshot).
+    // Move-only like StorageSnapshot; capture twice to get two independent frames.
+    struct RegistrySnapshot {
+        RegistrySnapshot() = default;
+        RegistrySnapshot(const RegistrySnapshot&) = delete;
+        RegistrySnapshot& operator=(const RegistrySnapshot&) = delete;
+        RegistrySnapshot(RegistrySnapshot&&) noexcept = default;
+        RegistrySnapshot& operator=(RegistrySnapshot&&) noexcept = default;
+
+        std::vector<bool> alive;
+        std::vector<Entity> free;
+        std::vector<ComponentMask> signatures;
+        std::uint32_t tick = 0;
+
+        std::vector<StorageSnapshot> storages; // indexed by component type ID
+        std::vector<std::size_t> groupSizes;   // registry group order
+
+        std::size_t byteSize() const {
+            std::size_t bytes = alive.size() / 8 + free.size() * sizeof(Entity) + signatures.size() * sizeof(ComponentMask);
+            for (const auto& st : storages) bytes += st.byteSize();
+            return bytes + groupSizes.size() * sizeof(std::size_t);
+        }
     };
 
     // ----------------------------
@@ -146,29 +693,64 @@ namespace HBE::ECS {
 
             Entity e = static_cast<Entity>(m_alive.size());
             m_alive.push_back(true);
+            m_signatures.emplace_back();
             return e;
         }
 
         void destroy(Entity e) {
             if (!valid(e)) return;
 
-            // remove components
-            for (auto& kv : m_storages) {
-                kv.second->onEntityDestroyed(e);
+            // remove components (only the storages this entity actually uses).
+            // Works on a copy: destroyed observers may create entities (which can
+            // reallocate m_signatures) or add other components to e, so repeat
+            // until the live signature is empty.
+            for (ComponentMask sig = m_signatures[e]; !sig.none(); sig = m_signatures[e]) {
+                sig.forEach([&](ComponentTypeID id) {
+                    if (!m_signatures[e].test(id)) return; // removed by an earlier observer
+                    IStorage* s = m_storages[id].get();
+                    if (!s->destroyed.empty()) s->destroyed.publish(*this, e);
+                    if (s->owner) s->owner->onDestroy(e);
+                    s->onEntityDestroyed(e);
+                    m_signatures[e].reset(id);
+                    });
             }
 
             m_alive[e] = false;
             m_free.push_back(e);
         }
 
+        // Create 'count' entities with every component of 'prefab' (appended to out).
+        // Storages are reserved once and filled in one pass per component type.
+        // Defined in Prefab.h.
+        void instantiate(const Prefab& prefab, std::size_t count, std::vector<Entity>& out);
+
         bool valid(Entity e) const {
             return e != Null && e < m_alive.size() && m_alive[e];
         }
 
+        // make room for n more create() calls without reallocating
+        void reserveEntities(std::size_t n) {
+            const std::size_t recycled = std::min(n, m_free.size());
+            const std::size_t fresh = n - recycled;
+            m_alive.reserve(m_alive.size() + fresh);
+            m_signatures.reserve(m_signatures.size() + fresh);
+        }
+
+        // make room for n components of T in total
+        template<typename T>
+        void reserve(std::size_t n) {
+            getOrCreateStorage<T>()->reserve(n);
+        }
+
         template<typename T>
         bool has(Entity e) const {
-            const auto* s = tryStorage<T>();
-            return s ? s->has(e) : false;
+            return e < m_signatures.size() && m_signatures[e].test(ComponentType<T>());
+        }
+
+        // bit per component type the entity owns (empty for dead entities)
+        const ComponentMask& signature(Entity e) const {
+            static const ComponentMask empty{};
+            return (e < m_signatures.size()) ? m_signatures[e] : empty;
         }
 
         template<typename T>
@@ -186,14 +768,203 @@ namespace HBE::ECS {
 
         template<typename T, typename... Args>
         T& emplace(Entity e, Args&&... args) {
+            assert(valid(e) && "Registry::emplace on an invalid entity");
             auto* s = getOrCreateStorage<T>();
-            return s->emplace(e, std::forward<Args>(args)...);
+            const bool existed = s->has(e);
+
+            s->emplace(e, std::forward<Args>(args)...);
+            s->setChangedTick(e, m_tick);
+
+            if (!existed) {
+                m_signatures[e].set(ComponentType<T>());
+
+                // owning group may move the new component into its packed range
+                if (s->owner) s->owner->onConstruct(e);
+                if (!s->constructed.empty()) s->constructed.publish(*this, e);
+            }
+            else if (!s->updated.empty()) {
+                s->updated.publish(*this, e);
+            }
+
+            return s->get(e);
+        }
+
+        // Modify a component in place and mark it changed:
+        //   reg.patch<Collider2D>(e, [](Collider2D& c) { c.halfW = 8.0f; });
+        //   reg.patch<Transform2D>(e); // just mark changed after writing through get<T>()
+        // Fires onUpdate<T> observers.
+        template<typename T, typename... Func>
+        T& patch(Entity e, Func&&... funcs) {
+            auto* s = tryStorage<T>();
+            assert(s && s->has(e) && "Registry::patch but entity doesn't have component");
+
+            T& ref = s->get(e);
+            (funcs(ref), ...);
+
+            s->setChangedTick(e, m_tick);
+            if (!s->updated.empty()) s->updated.publish(*this, e);
+            return ref;
         }
 
         template<typename T>
         void remove(Entity e) {
             auto* s = tryStorage<T>();
-            if (s) s->remove(e);
+            if (!s || !s->has(e)) return;
+
+            if (!s->destroyed.empty()) s->destroyed.publish(*this, e);
+            if (s->owner) s->owner->onDestroy(e);
+            s->remove(e);
+            m_signatures[e].reset(ComponentType<T>());
+        }
+
+        // ---- ordering ----
+        // Reorder T's dense arrays in place so iteration (view/each) follows
+        // comp(const T&, const T&). Insertion sort first: when the order barely changed
+        // since the last call (typical frame to frame) this is ~O(n) with a few swaps.
+        // If it turns out to be far from sorted it falls back to a full sort.
+        // Not allowed on storages owned by a group (the group controls their order).
+        template<typename T, typename Compare>
+        void sort(Compare comp) {
+            auto* s = tryStorage<T>();
+            if (!s) return;
+            assert(!s->owner && "Registry::sort on a group-owned storage");
+
+            const std::size_t n = s->size();
+            std::size_t budget = n * 4 + 64; // swaps we accept before giving up on insertion sort
+
+            for (std::size_t i = 1; i < n; ++i) {
+                for (std::size_t j = i; j > 0 && comp(s->dataAt(j), s->dataAt(j - 1)); --j) {
+                    s->swapDense(j, j - 1);
+                    if (--budget == 0) {
+                        sortFull(*s, comp);
+                        return;
+                    }
+                }
+            }
+        }
+
+        // Reorder To so that entities which also have From come first, in From's order.
+        // Use to make a companion storage follow a sorted one (e.g. sort<A>(), then sortAs<B, A>()).
+        template<typename To, typename From>
+        void sortAs() {
+            auto* to = tryStorage<To>();
+            const auto* from = tryStorage<From>();
+            if (!to || !from) return;
+            assert(!to->owner && "Registry::sortAs on a group-owned storage");
+
+            std::size_t pos = 0;
+            for (Entity e : from->denseEntities()) {
+                if (!to->has(e)) continue;
+                to->swapDense(to->indexOf(e), pos++);
+            }
+        }
+
+        // ---- change detection ----
+        // Systems remember currentTick() after they run and later ask what changed since.
+        std::uint32_t currentTick() const { return m_tick; }
+        std::uint32_t advanceTick() { return ++m_tick; }
+
+        // version of T's storage (0 if it doesn't exist); changes on construct/patch/remove
+        template<typename T>
+        std::uint64_t storageVersion() const {
+            const auto* s = tryStorage<T>();
+            return s ? s->version() : 0;
+        }
+
+        // true if e's T was constructed or patched after 'sinceTick'
+        template<typename T>
+        bool changedSince(Entity e, std::uint32_t sinceTick) const {
+            const auto* s = tryStorage<T>();
+            return s && s->changedTick(e) > sinceTick;
+        }
+
+        // func(Entity, T&) for every T constructed or patched after 'sinceTick'
+        template<typename T, typename Func>
+        void eachChangedSince(std::uint32_t sinceTick, Func&& func) {
+            auto* s = tryStorage<T>();
+            if (!s) return;
+
+            const auto& dense = s->denseEntities();
+            for (std::size_t i = 0; i < dense.size(); ++i) {
+                if (s->changedTickAt(i) > sinceTick) func(dense[i], s->dataAt(i));
+            }
+        }
+
+        // ---- snapshot / restore ----
+        // Copy every entity and storage into 'out' (reusing its buffers).
+        // Trivially copyable components are memcpy'd; the rest are copy constructed
+        // or go through a clone hook registered with setCloneHook<T>().
+        void saveSnapshot(RegistrySnapshot& out) const {
+            out.alive = m_alive;
+            out.free = m_free;
+            out.signatures = m_signatures;
+            out.tick = m_tick;
+
+            out.storages.resize(m_storages.size());
+            for (std::size_t i = 0; i < m_storages.size(); ++i) {
+                if (m_storages[i]) m_storages[i]->saveState(out.storages[i]);
+                else out.storages[i].present = false;
+            }
+
+            out.groupSizes.clear();
+            for (const auto& g : m_groups) out.groupSizes.push_back(g->packedSize());
+        }
+
+        // Put the registry back to the state captured in 'in' (taken from this registry).
+        // Observers don't fire. Storage versions are bumped so cached data rebuilds,
+        // and the tick keeps counting forward from the later of the two.
+        void loadSnapshot(const RegistrySnapshot& in) {
+            static const StorageSnapshot s_empty;
+
+            m_alive = in.alive;
+            m_free = in.free;
+            m_signatures = in.signatures;
+            m_tick = std::max(m_tick, in.tick) + 1;
+            ++m_snapshotLoads;
+
+            for (std::size_t i = 0; i < m_storages.size(); ++i) {
+                if (!m_storages[i]) {
+                    assert((i >= in.storages.size() || !in.storages[i].present) && "Registry::loadSnapshot from a different registry");
+                    continue;
+                }
+                const bool present = i < in.storages.size() && in.storages[i].present;
+                m_storages[i]->loadState(present ? in.storages[i] : s_empty);
+            }
+
+            // groups created after the snapshot have to re-partition their storages
+            for (std::size_t i = 0; i < m_groups.size(); ++i) {
+                if (i < in.groupSizes.size()) m_groups[i]->setPackedSize(in.groupSizes[i]);
+                else m_groups[i]->rebuild();
+            }
+        }
+
+        // number of loadSnapshot() calls; observer-driven caches compare it to catch restores
+        std::uint64_t snapshotLoads() const { return m_snapshotLoads; }
+
+        // snapshot copy function for T (required if T isn't copy constructible)
+        template<typename T>
+        void setCloneHook(std::function<T(const T&)> clone) {
+            getOrCreateStorage<T>()->setCloneHook(std::move(clone));
+        }
+
+        // ---- observers ----
+        // Construct/update observers run after the change, destroy observers run
+        // before the component is removed. Observers must not add or remove T.
+        template<typename T>
+        ObserverHandle onConstruct(ObserverFn fn) { return connect<T>(getOrCreateStorage<T>()->constructed, std::move(fn)); }
+
+        template<typename T>
+        ObserverHandle onUpdate(ObserverFn fn) { return connect<T>(getOrCreateStorage<T>()->updated, std::move(fn)); }
+
+        template<typename T>
+        ObserverHandle onDestroy(ObserverFn fn) { return connect<T>(getOrCreateStorage<T>()->destroyed, std::move(fn)); }
+
+        void disconnect(ObserverHandle h) {
+            if (h.id == 0 || h.type >= m_storages.size() || !m_storages[h.type]) return;
+            IStorage* s = m_storages[h.type].get();
+            if (!s->constructed.disconnect(h.id) && !s->updated.disconnect(h.id)) {
+                s->destroyed.disconnect(h.id);
+            }
         }
 
         template<typename... Components>
@@ -201,36 +972,122 @@ namespace HBE::ECS {
             return View<Components...>(*this);
         }
 
+        // Per-storage memory usage (one entry per component type in use)
+        std::vector<StorageMemoryStats> memoryReport() const {
+            std::vector<StorageMemoryStats> out;
+            out.reserve(m_storages.size());
+            for (const auto& storage : m_storages) {
+                if (storage) out.push_back(storage->memoryStats());
+            }
+            return out;
+        }
+
+        // Owning group over Owned... (created on first call, then kept up to date).
+        // A storage can be owned by one group only; asking for a different
+        // group that owns an already-owned component is an error.
+        template<typename... Owned>
+        Group<Owned...> group() {
+            using Handler = GroupHandler<Owned...>;
+            using Lead = typename Group<Owned...>::Lead;
+
+            IStorage* lead = getOrCreateStorage<Lead>();
+            if (lead->owner) {
+                auto* existing = dynamic_cast<Handler*>(lead->owner);
+                assert(existing && "Registry::group: component already owned by another group");
+                return Group<Owned...>(existing);
+            }
+
+            assert(((getOrCreateStorage<Owned>()->owner == nullptr) && ...) &&
+                "Registry::group: component already owned by another group");
+
+            auto handler = std::make_unique<Handler>(getOrCreateStorage<Owned>()...);
+            Handler* raw = handler.get();
+            ((getOrCreateStorage<Owned>()->owner = raw), ...);
+            m_groups.push_back(std::move(handler));
+
+            // pack entities that already have every owned component
+            const std::vector<Entity> existing = getOrCreateStorage<Lead>()->denseEntities();
+            for (Entity e : existing) {
+                raw->onConstruct(e);
+            }
+
+            return Group<Owned...>(raw);
+        }
+
         // internal helpers (used by View)
         template<typename T>
         Storage<T>* tryStorage() {
-            auto it = m_storages.find(std::type_index(typeid(T)));
-            return (it == m_storages.end()) ? nullptr : static_cast<Storage<T>*>(it->second.get());
+            const ComponentTypeID id = ComponentType<T>();
+            return (id < m_storages.size()) ? static_cast<Storage<T>*>(m_storages[id].get()) : nullptr;
         }
 
         template<typename T>
         const Storage<T>* tryStorage() const {
-            auto it = m_storages.find(std::type_index(typeid(T)));
-            return (it == m_storages.end()) ? nullptr : static_cast<const Storage<T>*>(it->second.get());
+            const ComponentTypeID id = ComponentType<T>();
+            return (id < m_storages.size()) ? static_cast<const Storage<T>*>(m_storages[id].get()) : nullptr;
         }
 
         template<typename T>
         Storage<T>* getOrCreateStorage() {
-            auto key = std::type_index(typeid(T));
-            auto it = m_storages.find(key);
-            if (it != m_storages.end()) return static_cast<Storage<T>*>(it->second.get());
+            const ComponentTypeID id = ComponentType<T>();
+            if (id >= m_storages.size()) m_storages.resize(id + 1);
 
-            auto ptr = std::make_unique<Storage<T>>();
-            Storage<T>* raw = ptr.get();
-            m_storages.emplace(key, std::move(ptr));
-            return raw;
+            auto& slot = m_storages[id];
+            if (!slot) slot = std::make_unique<Storage<T>>();
+            return static_cast<Storage<T>*>(slot.get());
         }
 
     private:
         std::vector<bool> m_alive{ false }; // index 0 reserved for Null
         std::vector<Entity> m_free;
 
-        std::unordered_map<std::type_index, std::unique_ptr<IStorage>> m_storages;
+        // per-entity component bits, parallel to m_alive
+        std::vector<ComponentMask> m_signatures{ ComponentMask{} };
+
+        // change-detection clock (starts at 1 so "since 0" means "ever")
+        std::uint32_t m_tick = 1;
+        std::uint32_t m_nextObserverId = 1;
+        std::uint64_t m_snapshotLoads = 0;
+
+        // sort() fallback: sort a permutation, then apply it with swaps
+        template<typename T, typename Compare>
+        static void sortFull(Storage<T>& s, Compare& comp) {
+            const std::size_t n = s.size();
+
+            std::vector<std::size_t> order(n);
+            for (std::size_t i = 0; i < n; ++i) order[i] = i;
+            std::stable_sort(order.begin(), order.end(), [&](std::size_t a, std::size_t b) {
+                return comp(s.dataAt(a), s.dataAt(b));
+                });
+
+            // pos[k] = current slot of the element originally at k, at[i] = original index now in slot i
+            std::vector<std::size_t> pos(order.size()), at(order.size());
+            for (std::size_t i = 0; i < n; ++i) pos[i] = at[i] = i;
+
+            for (std::size_t i = 0; i < n; ++i) {
+                const std::size_t j = pos[order[i]];
+                if (j == i) continue;
+
+                s.swapDense(i, j);
+                at[j] = at[i];
+                pos[at[j]] = j;
+                at[i] = order[i];
+                pos[order[i]] = i;
+            }
+        }
+
+        template<typename T>
+        ObserverHandle connect(Signal& sig, ObserverFn fn) {
+            ObserverHandle h;
+            h.type = ComponentType<T>();
+            h.id = m_nextObserverId++;
+            sig.slots.emplace_back(h.id, std::move(fn));
+            return h;
+        }
+
+        // indexed by ComponentType<T>(); null for types this registry never stored
+        std::vector<std::unique_ptr<IStorage>> m_storages;
+        std::vector<std::unique_ptr<IGroupHandler>> m_groups;
 
         template<typename... Components>
         friend class View;
@@ -261,9 +1118,13 @@ namespace HBE::ECS {
             ([&] {
                 auto* st = m_reg.template tryStorage<Components>();
                 consider(st, st ? &st->denseEntities() : nullptr);
+                m_mask.set(ComponentType<Components>());
+                std::get<Storage<Components>*>(m_storages) = st;
                 }(), 0)...
         };
 
+        m_complete = ((std::get<Storage<Components>*>(m_storages) != nullptr) && ...);
+
         // if none exist, set empty
         if (!m_driverDense) {
             static const std::vector<Entity> empty;
@@ -273,12 +1134,8 @@ namespace HBE::ECS {
 
     template<typename... Components>
     bool View<Components...>::matchesAll(Entity e) const {
-        // must have all components
-        bool ok = true;
-        (void)std::initializer_list<int>{
-            (ok = ok && m_reg.template has<Components>(e), 0)...
-        };
-        return ok;
+        // must have all components: one mask test against the entity signature
+        return m_reg.m_signatures[e].containsAll(m_mask);
     }
 
     template<typename... Components>
@@ -322,4 +1179,64 @@ namespace HBE::ECS {
         return *this;
     }
 
+    template<typename... Components>
+    template<typename C>
+    C& View<Components...>::fetch(Entity e, std::size_t driverIndex) const {
+        Storage<C>* st = std::get<Storage<C>*>(m_storages);
+        return (static_cast<IStorage*>(st) == m_driver) ? st->dataAt(driverIndex) : st->get(e);
+    }
+
+    template<typename... Components>
+    std::tuple<Entity, Components&...> View<Components...>::EachIterator::operator*() const {
+        const Entity e = *it;
+        return std::tuple<Entity, Components&...>(e, it.view->template fetch<Components>(e, it.index)...);
+    }
+
+    template<typename... Components>
+    template<typename Func>
+    void View<Components...>::eachRange(Func& func, std::size_t begin, std::size_t end) {
+        const std::vector<Entity>& dense = *m_driverDense;
+        const auto& signatures = m_reg.m_signatures;
+
+        for (std::size_t i = begin; i < end; ++i) {
+            const Entity e = dense[i];
+            if (!signatures[e].containsAll(m_mask)) continue;
+
+            if constexpr (std::is_invocable_v<Func&, Entity, Components&...>) {
+                func(e, fetch<Components>(e, i)...);
+            }
+            else {
+                func(fetch<Components>(e, i)...);
+            }
+        }
+    }
+
+    template<typename... Components>
+    template<typename Func>
+    void View<Components...>::each(Func&& func) {
+        initDriver();
+        if (!m_complete) return;
+
+        eachRange(func, 0, m_driverDense->size());
+    }
+
+    template<typename... Components>
+    template<typename Func>
+    void View<Components...>::parallelEach(Func&& func, std::size_t minChunk) {
+        initDriver();
+        if (!m_complete) return;
+
+        const std::size_t n = m_driverDense->size();
+
+        HBE::Core::JobSystem* jobs = HBE::Core::JobSystem::Get();
+        if (!jobs) {
+            eachRange(func, 0, n);
+            return;
+        }
+
+        jobs->parallelFor(n, minChunk, [this, &func](std::size_t begin, std::size_t end) {
+            eachRange(func, begin, end);
+            });
+    }
+
 }
\ No newline at end of file
@@ -18,4 +18,10 @@ namespace HBE::ECS {
     struct TagComponent {
         std::string tag;
     };
+
+    // Static collider generated from a tile rectangle (Scene2D::setTileRectColliders).
+    // Owned by the scene: not serialized, recreated from the tile layer.
+    struct TileRectColliderComponent {
+        int rect = -1;
+    };
 }
\ No newline at end of file
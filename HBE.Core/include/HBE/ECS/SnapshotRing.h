@@ -0,0 +1,97 @@
+#pragma once
+
+#include "HBE/ECS/Registry.h"
+
+#include <chrono>
+#include <cstdint>
+#include <vector>
+
+namespace HBE::ECS {
+
+    struct SnapshotStats {
+        std::size_t lastBytes = 0;        // size of the most recent capture
+        double lastCaptureMicros = 0.0;
+        double lastRestoreMicros = 0.0;
+        std::size_t framesHeld = 0;       // valid slots in the ring
+    };
+
+    // ----------------------------
+    // SnapshotRing
+    // Fixed number of registry snapshots keyed by frame number, for rollback
+    // (re-simulate from an older frame) and short instant replays.
+    // Slots are reused round-robin; their buffers keep their capacity, so
+    // steady-state capture doesn't allocate.
+    // ----------------------------
+    class SnapshotRing {
+    public:
+        explicit SnapshotRing(std::size_t frames = 8) : m_slots(frames > 0 ? frames : 1) {}
+
+        std::size_t capacity() const { return m_slots.size(); }
+
+        void capture(const Registry& reg, std::uint64_t frame) {
+            const auto t0 = Clock::now();
+
+            Slot& slot = m_slots[frame % m_slots.size()];
+            reg.saveSnapshot(slot.snapshot);
+            slot.frame = frame;
+            slot.valid = true;
+
+            m_stats.lastCaptureMicros = microsSince(t0);
+            m_stats.lastBytes = slot.snapshot.byteSize();
+            m_stats.framesHeld = countValid();
+        }
+
+        bool has(std::uint64_t frame) const {
+            const Slot& slot = m_slots[frame % m_slots.size()];
+            return slot.valid && slot.frame == frame;
+        }
+
+        // false if the frame was never captured or has been overwritten
+        bool restore(Registry& reg, std::uint64_t frame) {
+            if (!has(frame)) return false;
+
+            const auto t0 = Clock::now();
+            reg.loadSnapshot(m_slots[frame % m_slots.size()].snapshot);
+            m_stats.lastRestoreMicros = microsSince(t0);
+            return true;
+        }
+
+        // forget every frame newer than 'frame' (after a rollback they are stale)
+        void discardAfter(std::uint64_t frame) {
+            for (Slot& slot : m_slots) {
+                if (slot.valid && slot.frame > frame) slot.valid = false;
+            }
+            m_stats.framesHeld = countValid();
+        }
+
+        void clear() {
+            for (Slot& slot : m_slots) slot.valid = false;
+            m_stats.framesHeld = 0;
+        }
+
+        const SnapshotStats& stats() const { return m_stats; }
+
+    private:
+        using Clock = std::chrono::steady_clock;
+
+        struct Slot {
+            RegistrySnapshot snapshot;
+            std::uint64_t frame = 0;
+            bool valid = false;
+        };
+
+        std::vector<Slot> m_slots;
+        SnapshotStats m_stats{};
+
+        static double microsSince(Clock::time_point t0) {
+            return std::chrono::duration<double, std::micro>(Clock::now() - t0).count();
+        }
+
+        std::size_t countValid() const {
+            std::size_t n = 0;
+            for (const Slot& slot : m_slots) if (slot.valid) ++n;
+            return n;
+        }
+    };
+
+}
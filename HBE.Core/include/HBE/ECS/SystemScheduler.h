@@ -0,0 +1,252 @@
+#pragma once
+
+#include "HBE/ECS/Registry.h"
+#include "HBE/Core/JobSystem.h"
+
+#include <chrono>
+#include <functional>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace HBE::ECS {
+
+    // ----------------------------
+    // SystemAccess
+    // Which components a system reads and writes. Two systems conflict when one
+    // writes something the other reads or writes; conflicting systems keep their
+    // registration order, everything else may run at the same time.
+    //   SystemAccess{}.read<Collider2D>().write<Transform2D, RigidBody2D>()
+    // ----------------------------
+    class SystemAccess {
+    public:
+        template<typename... T>
+        SystemAccess& read() {
+            (add<T>(m_reads), ...);
+            return *this;
+        }
+
+        template<typename... T>
+        SystemAccess& write() {
+            (add<T>(m_writes), ...);
+            return *this;
+        }
+
+        // Runs alone, on the thread that calls SystemScheduler::run.
+        // For systems that change the registry structurally or call back into game code.
+        SystemAccess& exclusive() {
+            m_exclusive = true;
+            return *this;
+        }
+
+        bool isExclusive() const { return m_exclusive; }
+        const ComponentMask& reads() const { return m_reads; }
+        const ComponentMask& writes() const { return m_writes; }
+
+        bool conflictsWith(const SystemAccess& o) const {
+            if (m_exclusive || o.m_exclusive) return true;
+            return m_writes.intersects(o.m_writes)
+                || m_writes.intersects(o.m_reads)
+                || o.m_writes.intersects(m_reads);
+        }
+
+        // create every touched storage up front (storage creation isn't thread safe)
+        void prepare(Registry& reg) const {
+            for (auto fn : m_prepare) fn(reg);
+        }
+
+    private:
+        ComponentMask m_reads;
+        ComponentMask m_writes;
+        bool m_exclusive = false;
+        std::vector<void(*)(Registry&)> m_prepare;
+
+        template<typename T>
+        void add(ComponentMask& mask) {
+            mask.set(ComponentType<T>());
+            m_prepare.push_back([](Registry& reg) { reg.reserve<T>(0); });
+        }
+    };
+
+    struct SystemTiming {
+        std::string name;
+        int wave = 0;               // systems in the same wave ran concurrently
+        double micros = 0.0;
+        double finishMicros = 0.0;  // earliest possible finish given its dependencies
+        bool onCriticalPath = false;
+    };
+
+    struct ScheduleStats {
+        double totalMicros = 0.0;         // wall time of run()
+        double serialMicros = 0.0;        // sum of all systems (time a sequential run would take)
+        double criticalPathMicros = 0.0;  // longest dependency chain; lower bound for run()
+        int waveCount = 0;
+        std::vector<SystemTiming> systems; // registration order
+    };
+
+    // ----------------------------
+    // SystemScheduler
+    // Runs registered systems once per run() call. Systems are grouped into waves:
+    // a system goes one wave after the last earlier system it conflicts with.
+    // Systems within a wave run concurrently on the job system; waves run in order.
+    // Chunking inside a system is up to the system (e.g. View::parallelEach).
+    // ----------------------------
+    class SystemScheduler {
+    public:
+        using SystemFn = std::function<void(Registry&, float)>;
+
+        std::size_t add(std::string name, SystemAccess access, SystemFn fn) {
+            System s;
+            s.name = std::move(name);
+            s.access = std::move(access);
+            s.fn = std::move(fn);
+            m_systems.push_back(std::move(s));
+            m_dirty = true;
+            return m_systems.size() - 1;
+        }
+
+        void clear() {
+            m_systems.clear();
+            m_waves.clear();
+            m_stats = ScheduleStats{};
+            m_dirty = false;
+        }
+
+        std::size_t systemCount() const { return m_systems.size(); }
+
+        // false = run every system in registration order on the calling thread
+        void setParallel(bool parallel) { m_parallel = parallel; }
+        bool parallel() const { return m_parallel; }
+
+        void run(Registry& reg, float dt) {
+            if (m_dirty) build();
+
+            const auto frameStart = Clock::now();
+
+            for (const System& s : m_systems) {
+                s.access.prepare(reg);
+            }
+
+            for (const std::vector<std::size_t>& wave : m_waves) {
+                if (!m_parallel || wave.size() == 1) {
+                    for (std::size_t idx : wave) runOne(idx, reg, dt);
+                    continue;
+                }
+
+                HBE::Core::JobSystem* jobs = HBE::Core::JobSystem::Get();
+                if (!jobs) {
+                    for (std::size_t idx : wave) runOne(idx, reg, dt);
+                    continue;
+                }
+
+                // first system on this thread, the rest as jobs
+                HBE::Core::JobHandle pending;
+                for (std::size_t i = 1; i < wave.size(); ++i) {
+                    const std::size_t idx = wave[i];
+                    jobs->schedule([this, idx, &reg, dt] { runOne(idx, reg, dt); }, pending);
+                }
+
+                runOne(wave[0], reg, dt);
+                jobs->wait(pending);
+            }
+
+            m_stats.totalMicros = microsSince(frameStart);
+            collectStats();
+        }
+
+        const ScheduleStats& stats() const { return m_stats; }
+
+    private:
+        using Clock = std::chrono::steady_clock;
+
+        struct System {
+            std::string name;
+            SystemAccess access;
+            SystemFn fn;
+
+            std::vector<std::size_t> deps; // earlier systems this one conflicts with
+            int wave = 0;
+            double micros = 0.0;
+        };
+
+        std::vector<System> m_systems;
+        std::vector<std::vector<std::size_t>> m_waves;
+        ScheduleStats m_stats{};
+        bool m_dirty = false;
+        bool m_parallel = true;
+
+        static double microsSince(Clock::time_point t0) {
+            return std::chrono::duration<double, std::micro>(Clock::now() - t0).count();
+        }
+
+        void runOne(std::size_t idx, Registry& reg, float dt) {
+            System& s = m_systems[idx];
+            const auto t0 = Clock::now();
+            s.fn(reg, dt);
+            s.micros = microsSince(t0);
+        }
+
+        void build() {
+            m_waves.clear();
+
+            for (std::size_t j = 0; j < m_systems.size(); ++j) {
+                System& sj = m_systems[j];
+                sj.deps.clear();
+                sj.wave = 0;
+
+                for (std::size_t i = 0; i < j; ++i) {
+                    if (!m_systems[i].access.conflictsWith(sj.access)) continue;
+                    sj.deps.push_back(i);
+                    sj.wave = std::max(sj.wave, m_systems[i].wave + 1);
+                }
+
+                if (static_cast<std::size_t>(sj.wave) >= m_waves.size()) m_waves.resize(sj.wave + 1);
+                m_waves[sj.wave].push_back(j);
+            }
+
+            m_dirty = false;
+        }
+
+        void collectStats() {
+            const std::size_t n = m_systems.size();
+            m_stats.systems.resize(n);
+            m_stats.waveCount = static_cast<int>(m_waves.size());
+            m_stats.serialMicros = 0.0;
+            m_stats.criticalPathMicros = 0.0;
+
+            // longest path through the dependency graph (systems are already topologically ordered)
+            std::vector<std::size_t> via(n, n);
+            std::size_t last = n;
+
+            for (std::size_t j = 0; j < n; ++j) {
+                const System& s = m_systems[j];
+                SystemTiming& t = m_stats.systems[j];
+
+                double start = 0.0;
+                for (std::size_t d : s.deps) {
+                    if (m_stats.systems[d].finishMicros > start) {
+                        start = m_stats.systems[d].finishMicros;
+                        via[j] = d;
+                    }
+                }
+
+                t.name = s.name;
+                t.wave = s.wave;
+                t.micros = s.micros;
+                t.finishMicros = start + s.micros;
+                t.onCriticalPath = false;
+
+                m_stats.serialMicros += s.micros;
+                if (t.finishMicros >= m_stats.criticalPathMicros) {
+                    m_stats.criticalPathMicros = t.finishMicros;
+                    last = j;
+                }
+            }
+
+            for (std::size_t j = last; j < n; j = via[j]) {
+                m_stats.systems[j].onCriticalPath = true;
+            }
+        }
+    };
+
+}
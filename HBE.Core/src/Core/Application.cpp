@@ -9,6 +9,8 @@
 #include <SDL3/SDL.h>
 #include <SDL3/SDL_scancode.h>
 
+#include <cmath>
+
 namespace HBE::Core {
 
 	using HBE::Core::LogError;
@@ -16,6 +18,8 @@ namespace HBE::Core {
 	using HBE::Core::LogFatal;
 
 	Application::~Application() {
+		// finish in-flight jobs while the layers they may reference still exist
+		m_jobs.shutdown();
 		m_layers.clear();
 		// SDLPlatform destructur already calls shutdown()
 	}
@@ -40,6 +44,11 @@ namespace HBE::Core {
 			return false;
 		}
 
+		if (!m_jobs.start()) {
+			LogError("Application: JobSystem start failed.");
+			return false;
+		}
+
 		recalcViewportAndNotify();
 
 		m_initialized = true;
@@ -287,6 +296,12 @@ namespace HBE::Core {
 		m_gl.resizeViewport(m_winW, m_winH);
 	}
 
+	void Application::setFixedUpdateRate(float hz, int maxStepsPerFrame) {
+		m_fixedDt = (hz > 0.0f) ? 1.0f / hz : 0.0f;
+		m_maxFixedSteps = (maxStepsPerFrame > 0) ? maxStepsPerFrame : 1;
+		m_fixedAccumulator = 0.0;
+	}
+
 	void Application::run() {
 		if (!m_initialized) {
 			LogError("Application::run called before initialize()");
@@ -313,6 +328,9 @@ namespace HBE::Core {
 				break;
 			}
 
+			// GL/window work queued by other threads
+			m_jobs.runMainThreadJobs();
+
 			// dt
 			double now = GetTimeSeconds();
 			float dt = static_cast<float>(now - prevTime);
@@ -320,6 +338,31 @@ namespace HBE::Core {
 			if (dt > 0.25f) dt = 0.25f;
 			prevTime = now;
 
+			// fixed-rate simulation steps
+			int steps = 0;
+			if (m_fixedDt > 0.0f) {
+				m_fixedAccumulator += dt;
+
+				while (m_fixedAccumulator >= m_fixedDt && steps < m_maxFixedSteps) {
+					for (auto& layer : m_layers) {
+						if (layer) layer->onFixedUpdate(m_fixedDt);
+					}
+					m_fixedAccumulator -= m_fixedDt;
+					++steps;
+				}
+
+				// over budget: drop whole steps we can't afford, keep the fraction for alpha
+				if (m_fixedAccumulator >= m_fixedDt) {
+					m_fixedAccumulator = std::fmod(m_fixedAccumulator, (double)m_fixedDt);
+				}
+
+				m_fixedAlpha = static_cast<float>(m_fixedAccumulator / m_fixedDt);
+			}
+			else {
+				m_fixedAlpha = 1.0f;
+			}
+			m_fixedStepsLastFrame = steps;
+
 			// update
 			for (auto& layer : m_layers) {
 				if (layer) layer->onUpdate(dt);
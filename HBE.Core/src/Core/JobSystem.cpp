@@ -0,0 +1,253 @@
+#include "HBE/Core/JobSystem.h"
+#include "HBE/Core/Log.h"
+
+#include <algorithm>
+#include <exception>
+#include <string>
+
+namespace HBE::Core {
+
+	static std::atomic<JobSystem*> s_instance{ nullptr };
+
+	// which system/worker the current thread belongs to
+	static thread_local const JobSystem* t_owner = nullptr;
+	static thread_local int t_workerIndex = -1;
+
+	JobSystem::~JobSystem() {
+		shutdown();
+	}
+
+	JobSystem* JobSystem::Get() {
+		return s_instance.load(std::memory_order_acquire);
+	}
+
+	bool JobSystem::start(unsigned workerCount) {
+		if (running()) return true;
+
+		if (workerCount == 0) {
+			const unsigned hw = std::thread::hardware_concurrency();
+			workerCount = (hw > 1) ? hw - 1 : 1;
+		}
+
+		m_mainThread = std::this_thread::get_id();
+
+		m_queues.clear();
+		for (unsigned i = 0; i < workerCount; ++i) {
+			m_queues.push_back(std::make_unique<WorkerQueue>());
+		}
+
+		m_running.store(true, std::memory_order_release);
+
+		m_workers.reserve(workerCount);
+		for (unsigned i = 0; i < workerCount; ++i) {
+			m_workers.emplace_back([this, i] { workerLoop(static_cast<int>(i)); });
+		}
+
+		JobSystem* expected = nullptr;
+		s_instance.compare_exchange_strong(expected, this);
+
+		LogInfo("JobSystem: started " + std::to_string(workerCount) + " workers.");
+		return true;
+	}
+
+	void JobSystem::shutdown() {
+		if (!running()) return;
+
+		{
+			std::lock_guard<std::mutex> lock(m_sleepMutex);
+			m_running.store(false, std::memory_order_release);
+		}
+		m_wake.notify_all();
+
+		for (auto& t : m_workers) {
+			if (t.joinable()) t.join();
+		}
+		m_workers.clear();
+		m_queues.clear();
+
+		// nobody will call runMainThreadJobs() anymore
+		runMainThreadJobs();
+
+		JobSystem* expected = this;
+		s_instance.compare_exchange_strong(expected, nullptr);
+	}
+
+	int JobSystem::currentWorkerIndex() const {
+		return (t_owner == this) ? t_workerIndex : -1;
+	}
+
+	JobHandle JobSystem::schedule(JobFn fn) {
+		JobHandle handle;
+		schedule(std::move(fn), handle);
+		return handle;
+	}
+
+	void JobSystem::schedule(JobFn fn, JobHandle& handle) {
+		if (!handle.m_counter) handle.m_counter = std::make_shared<std::atomic<int>>(0);
+		handle.m_counter->fetch_add(1, std::memory_order_relaxed);
+
+		Job job{ std::move(fn), handle.m_counter };
+
+		// not started (or shutting down): run inline so callers never hang
+		if (!running()) {
+			execute(job);
+			return;
+		}
+
+		push(std::move(job));
+	}
+
+	void JobSystem::push(Job job) {
+		// workers push onto their own deque; other threads spread round-robin
+		int target = currentWorkerIndex();
+		if (target < 0) {
+			target = static_cast<int>(m_nextQueue.fetch_add(1, std::memory_order_relaxed) % m_queues.size());
+		}
+
+		// count first so a sleeping worker never misses this job
+		m_queued.fetch_add(1, std::memory_order_acq_rel);
+		{
+			WorkerQueue& q = *m_queues[target];
+			std::lock_guard<std::mutex> lock(q.mutex);
+			q.jobs.push_back(std::move(job));
+		}
+
+		{
+			std::lock_guard<std::mutex> lock(m_sleepMutex);
+		}
+		m_wake.notify_one();
+	}
+
+	bool JobSystem::tryRunOne(int selfIndex) {
+		const std::size_t count = m_queues.size();
+		if (count == 0) return false;
+
+		Job job;
+		bool found = false;
+
+		// own queue: newest first (still hot in cache)
+		if (selfIndex >= 0) {
+			WorkerQueue& q = *m_queues[selfIndex];
+			std::lock_guard<std::mutex> lock(q.mutex);
+			if (!q.jobs.empty()) {
+				job = std::move(q.jobs.back());
+				q.jobs.pop_back();
+				found = true;
+			}
+		}
+
+		// steal: oldest job of another worker
+		if (!found) {
+			const std::size_t first = (selfIndex >= 0) ? static_cast<std::size_t>(selfIndex) + 1
+				: m_nextQueue.load(std::memory_order_relaxed);
+
+			for (std::size_t i = 0; i < count && !found; ++i) {
+				const std::size_t victim = (first + i) % count;
+				if (static_cast<int>(victim) == selfIndex) continue;
+
+				WorkerQueue& q = *m_queues[victim];
+				std::lock_guard<std::mutex> lock(q.mutex);
+				if (!q.jobs.empty()) {
+					job = std::move(q.jobs.front());
+					q.jobs.pop_front();
+					found = true;
+				}
+			}
+		}
+
+		if (!found) return false;
+
+		m_queued.fetch_sub(1, std::memory_order_acq_rel);
+		execute(job);
+		return true;
+	}
+
+	void JobSystem::execute(Job& job) {
+		try {
+			if (job.fn) job.fn();
+		}
+		catch (const std::exception& e) {
+			LogError(std::string("JobSystem: job threw: ") + e.what());
+		}
+		catch (...) {
+			LogError("JobSystem: job threw an unknown exception.");
+		}
+
+		if (job.counter) job.counter->fetch_sub(1, std::memory_order_acq_rel);
+	}
+
+	void JobSystem::workerLoop(int index) {
+		t_owner = this;
+		t_workerIndex = index;
+
+		for (;;) {
+			if (tryRunOne(index)) continue;
+
+			std::unique_lock<std::mutex> lock(m_sleepMutex);
+			m_wake.wait(lock, [this] {
+				return m_queued.load(std::memory_order_acquire) > 0 || !m_running.load(std::memory_order_acquire);
+				});
+
+			// drain before exiting so shutdown() never drops work
+			if (!m_running.load(std::memory_order_acquire) && m_queued.load(std::memory_order_acquire) <= 0) break;
+		}
+
+		t_owner = nullptr;
+		t_workerIndex = -1;
+	}
+
+	void JobSystem::wait(const JobHandle& handle) {
+		const int self = currentWorkerIndex();
+		while (!handle.done()) {
+			if (!tryRunOne(self)) std::this_thread::yield();
+		}
+	}
+
+	void JobSystem::parallelFor(std::size_t count, std::size_t minChunk, const std::function<void(std::size_t, std::size_t)>& fn) {
+		if (count == 0) return;
+		if (minChunk == 0) minChunk = 1;
+
+		// a few chunks per thread so stealing can even out uneven work
+		const std::size_t maxChunks = (static_cast<std::size_t>(workerCount()) + 1) * 4;
+		const std::size_t chunks = std::min(maxChunks, std::max<std::size_t>(1, count / minChunk));
+
+		if (!running() || chunks <= 1) {
+			fn(0, count);
+			return;
+		}
+
+		const std::size_t per = (count + chunks - 1) / chunks;
+
+		JobHandle handle;
+		for (std::size_t begin = per; begin < count; begin += per) {
+			const std::size_t end = std::min(count, begin + per);
+			schedule([&fn, begin, end] { fn(begin, end); }, handle);
+		}
+
+		// calling thread takes the first chunk, then helps with the rest
+		fn(0, std::min(count, per));
+		wait(handle);
+	}
+
+	JobHandle JobSystem::scheduleMainThread(JobFn fn) {
+		JobHandle handle;
+		handle.m_counter = std::make_shared<std::atomic<int>>(1);
+
+		std::lock_guard<std::mutex> lock(m_mainMutex);
+		m_mainJobs.push_back(Job{ std::move(fn), handle.m_counter });
+		return handle;
+	}
+
+	void JobSystem::runMainThreadJobs() {
+		std::vector<Job> jobs;
+		{
+			std::lock_guard<std::mutex> lock(m_mainMutex);
+			jobs.swap(m_mainJobs);
+		}
+
+		for (Job& job : jobs) {
+			execute(job);
+		}
+	}
+
+}
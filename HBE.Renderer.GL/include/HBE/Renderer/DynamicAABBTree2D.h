@@ -0,0 +1,156 @@
+#pragma once
+
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace HBE::Renderer {
+
+	struct Bounds2D {
+		float minX = 0.0f, minY = 0.0f;
+		float maxX = 0.0f, maxY = 0.0f;
+
+		bool overlaps(const Bounds2D& o) const {
+			return minX <= o.maxX && o.minX <= maxX && minY <= o.maxY && o.minY <= maxY;
+		}
+
+		bool contains(const Bounds2D& o) const {
+			return minX <= o.minX && minY <= o.minY && o.maxX <= maxX && o.maxY <= maxY;
+		}
+
+		bool containsPoint(float x, float y) const {
+			return x >= minX && x <= maxX && y >= minY && y <= maxY;
+		}
+
+		float perimeter() const { return 2.0f * ((maxX - minX) + (maxY - minY)); }
+
+		static Bounds2D merge(const Bounds2D& a, const Bounds2D& b) {
+			Bounds2D r;
+			r.minX = a.minX < b.minX ? a.minX : b.minX;
+			r.minY = a.minY < b.minY ? a.minY : b.minY;
+			r.maxX = a.maxX > b.maxX ? a.maxX : b.maxX;
+			r.maxY = a.maxY > b.maxY ? a.maxY : b.maxY;
+			return r;
+		}
+	};
+
+	// Segment p0 + t * d, t in [0, maxT], against a box (slab test).
+	// On hit: entry fraction (0 when starting inside) and the face normal (0,0 when inside).
+	bool SegmentVsBounds(const Bounds2D& b, float x0, float y0, float dx, float dy, float maxT,
+		float& outT, float& outNx, float& outNy);
+
+	// Dynamic bounding volume hierarchy (binary, height balanced by rotations).
+	//
+	// Leaves keep the exact ("tight") box plus an enlarged ("fat") box used for the
+	// tree structure. moveProxy() only re-inserts a leaf once its tight box leaves
+	// the fat one, so small per-frame motion costs a compare. Queries report tight
+	// boxes, traverse with a fixed-size stack and never allocate, so const queries
+	// can run from several threads at once.
+	class DynamicAABBTree2D {
+	public:
+		static constexpr int Null = -1;
+
+		explicit DynamicAABBTree2D(float margin = 4.0f) : m_margin(margin) {}
+
+		int createProxy(const Bounds2D& tight, std::uint32_t userData);
+		void destroyProxy(int proxy);
+
+		// true if the leaf was re-inserted (tight box left the fat box)
+		bool moveProxy(int proxy, const Bounds2D& tight);
+
+		void clear();
+
+		std::uint32_t userData(int proxy) const { return m_nodes[proxy].userData; }
+		const Bounds2D& tightBounds(int proxy) const { return m_nodes[proxy].tight; }
+		const Bounds2D& fatBounds(int proxy) const { return m_nodes[proxy].fat; }
+
+		std::size_t proxyCount() const { return m_proxyCount; }
+		int height() const { return (m_root == Null) ? 0 : m_nodes[m_root].height; }
+
+		// fn(userData, tightBounds) -> bool (false stops the query) for every leaf overlapping 'box'
+		template<typename Fn>
+		void query(const Bounds2D& box, Fn&& fn) const {
+			int stack[StackSize];
+			int top = 0;
+			if (m_root != Null) stack[top++] = m_root;
+
+			while (top > 0) {
+				const Node& n = m_nodes[stack[--top]];
+				if (!n.fat.overlaps(box)) continue;
+
+				if (n.isLeaf()) {
+					if (n.tight.overlaps(box) && !fn(n.userData, n.tight)) return;
+				}
+				else if (top + 2 <= StackSize) {
+					stack[top++] = n.child1;
+					stack[top++] = n.child2;
+				}
+			}
+		}
+
+		// Segment p0 -> p1. fn(userData, tightBounds, fraction, maxFraction) -> float:
+		// return 0 to stop, a value in (0, maxFraction) to clip the segment there
+		// (closest hit queries return 'fraction'), maxFraction to keep going unclipped.
+		template<typename Fn>
+		void raycast(float x0, float y0, float x1, float y1, Fn&& fn) const {
+			const float dx = x1 - x0;
+			const float dy = y1 - y0;
+			float maxFraction = 1.0f;
+
+			int stack[StackSize];
+			int top = 0;
+			if (m_root != Null) stack[top++] = m_root;
+
+			while (top > 0) {
+				const Node& n = m_nodes[stack[--top]];
+
+				float t, nx, ny;
+				if (!SegmentVsBounds(n.fat, x0, y0, dx, dy, maxFraction, t, nx, ny)) continue;
+
+				if (n.isLeaf()) {
+					if (!SegmentVsBounds(n.tight, x0, y0, dx, dy, maxFraction, t, nx, ny)) continue;
+
+					const float r = fn(n.userData, n.tight, t, maxFraction);
+					if (r <= 0.0f) return;
+					if (r < maxFraction) maxFraction = r;
+				}
+				else if (top + 2 <= StackSize) {
+					stack[top++] = n.child1;
+					stack[top++] = n.child2;
+				}
+			}
+		}
+
+	private:
+		// a balanced tree of 2^32 leaves is far shallower than this
+		static constexpr int StackSize = 256;
+
+		struct Node {
+			Bounds2D fat;
+			Bounds2D tight;       // leaves only
+			int parent = Null;    // next free node while on the free list
+			int child1 = Null;
+			int child2 = Null;
+			int height = 0;       // leaf = 0, free = -1
+			std::uint32_t userData = 0;
+
+			bool isLeaf() const { return child1 == Null; }
+		};
+
+		std::vector<Node> m_nodes;
+		int m_root = Null;
+		int m_freeList = Null;
+		std::size_t m_proxyCount = 0;
+		float m_margin = 4.0f;
+
+		int allocateNode();
+		void freeNode(int node);
+
+		void insertLeaf(int leaf);
+		void removeLeaf(int leaf);
+		void refitUpwards(int node);
+		int balance(int a);
+	};
+
+}
@@ -0,0 +1,157 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "HBE/Renderer/TileCollisionGrid.h"
+
+namespace HBE::Renderer {
+
+	struct PathTile2D {
+		int x = 0;
+		int y = 0;
+	};
+
+	// How a platformer path gets to a tile from the previous one.
+	enum class PathMove2D : std::uint8_t {
+		Walk, // along the ground or a slope
+		Fall, // off a ledge
+		Drop, // down through a one-way platform
+		Jump, // across a gap or up onto a ledge / through a one-way platform
+	};
+
+	struct PathResult2D {
+		bool found = false;
+
+		// start .. goal. Top-down: jump points, consecutive ones lie on a straight or
+		// diagonal line. Platformer: standing tiles, moves[i] reaches tiles[i].
+		std::vector<PathTile2D> tiles;
+		std::vector<PathMove2D> moves;
+
+		float cost = 0.0f; // in tiles
+		int expanded = 0;  // nodes taken off the open list
+
+		double computeMicros = 0.0;
+		double producedAt = 0.0;       // HBE::Core::GetTimeSeconds()
+		std::uint64_t gridVersion = 0; // TileCollisionGrid::version() it was computed on
+	};
+
+	// Cost to one goal and the next step toward it, for every tile. Shared by all the
+	// agents heading there; never modified once produced.
+	class FlowField2D {
+	public:
+		int goalX() const { return m_goalX; }
+		int goalY() const { return m_goalY; }
+		int width() const { return m_w; }
+		int height() const { return m_h; }
+
+		bool reachable(int tx, int ty) const { return distance(tx, ty) >= 0.0f; }
+
+		// path cost to the goal in tiles, negative if unreachable
+		float distance(int tx, int ty) const {
+			if (tx < 0 || ty < 0 || tx >= m_w || ty >= m_h) return -1.0f;
+			return m_dist[static_cast<std::size_t>(ty) * m_w + tx];
+		}
+
+		// next tile toward the goal; false at the goal and on unreachable tiles
+		bool next(int tx, int ty, int& outX, int& outY) const;
+
+		// platformer: how to take the step to next()
+		PathMove2D move(int tx, int ty) const;
+
+		// unit vector toward next(), (0, 0) where there is none
+		void direction(int tx, int ty, float& outX, float& outY) const;
+
+		double computeMicros() const { return m_computeMicros; }
+		double producedAt() const { return m_producedAt; }
+		std::uint64_t gridVersion() const { return m_gridVersion; }
+
+	private:
+		int m_goalX = 0, m_goalY = 0;
+		int m_w = 0, m_h = 0;
+
+		std::vector<float> m_dist;
+		std::vector<int> m_next; // tile index, -1 = none
+		std::vector<PathMove2D> m_move;
+
+		double m_computeMicros = 0.0;
+		double m_producedAt = 0.0;
+		std::uint64_t m_gridVersion = 0;
+
+		friend class GridPathfinder2D;
+	};
+
+	// Navigation over a TileCollisionGrid.
+	//
+	// sync() copies the grid (and compiles the platformer graph) whenever its version
+	// changes, so searches never touch the live grid and flow fields can be built on
+	// the job system while the game edits tiles.
+	// - Top-down: 8-connected over tiles without BlockMask flags, no corner cutting.
+	//   findPath() runs Jump Point Search (plain A* when diagonal moves are off).
+	// - Platformer: nodes are tiles an agent can stand in (free, on top of a solid,
+	//   one-way or slope tile); edges walk, fall off ledges, drop through one-way
+	//   platforms and jump within maxJumpDistance x maxJumpHeight. findPath() runs A*.
+	// flowField() shares one field per goal tile between every caller.
+	class GridPathfinder2D {
+	public:
+		struct Settings {
+			bool platformer = false;
+			bool diagonal = true; // top-down
+
+			// platformer
+			int agentHeight = 1;     // free tiles needed from the standing tile up
+			int maxJumpDistance = 3; // tiles across
+			int maxJumpHeight = 2;   // tiles up or down (0 = no jumps)
+			float jumpCost = 2.0f;   // added to a jump's length
+			bool fallOffLedges = true;
+			bool dropThroughOneWay = true;
+
+			std::size_t maxFlowFields = 8; // cached goals, least recently requested evicted
+		};
+
+		GridPathfinder2D();
+		~GridPathfinder2D();
+
+		GridPathfinder2D(const GridPathfinder2D&) = delete;
+		GridPathfinder2D& operator=(const GridPathfinder2D&) = delete;
+
+		void setSettings(const Settings& settings);
+		const Settings& settings() const { return m_settings; }
+
+		// Recompile from 'grid' if it (or the settings) changed since the last call.
+		void sync(const TileCollisionGrid& grid);
+
+		// Synchronous. Platformer start/goal tiles in the air snap to the ground below.
+		PathResult2D findPath(int startX, int startY, int goalX, int goalY) const;
+
+		// Shared field toward (goalX, goalY). The first request, and the first one after
+		// the grid changed, schedules it on the job system (inline if it isn't running);
+		// meanwhile this returns the previous field for that goal (see gridVersion()) or null.
+		std::shared_ptr<const FlowField2D> flowField(int goalX, int goalY);
+
+		// block until every scheduled flow field is done
+		void waitFlowFields();
+
+		std::size_t pendingFlowFields() const;
+
+	private:
+		struct NavData;
+		struct FieldSlot;
+
+		Settings m_settings;
+		std::shared_ptr<const NavData> m_nav;
+
+		const TileCollisionGrid* m_source = nullptr;
+		std::uint64_t m_sourceVersion = 0;
+		bool m_dirty = true;
+		std::uint64_t m_generation = 0;
+
+		std::vector<std::shared_ptr<FieldSlot>> m_fields;
+		std::uint64_t m_requestClock = 0;
+
+		static std::shared_ptr<FlowField2D> ComputeFlowField(const NavData& nav, int goal);
+	};
+
+}
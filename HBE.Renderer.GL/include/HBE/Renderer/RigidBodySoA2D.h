@@ -0,0 +1,60 @@
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+#include "HBE/ECS/Entity.h"
+
+namespace HBE::ECS { struct RigidBody2D; }
+
+namespace HBE::Renderer {
+
+	struct Transform2D;
+
+	// Structure-of-arrays working set for the rigid body integrator.
+	// Components stay AoS in the registry (systems hold Transform2D& / RigidBody2D&),
+	// so physics gathers the bodies it can integrate in bulk into these arrays,
+	// runs every sub-step on them, then scatters position/velocity back once.
+	//
+	// Per-body branches are folded into data at gather time:
+	//   useGravity     -> gravityScale (0 when gravity is off)
+	//   linearDamping  -> damping (clamped to >= 0; 0 means no damping)
+	//   maxFallSpeed   -> minVelY (-inf when unclamped)
+	struct RigidBodySoA2D {
+		std::vector<float> posX, posY;
+		std::vector<float> velX, velY;
+		std::vector<float> accelX, accelY;
+		std::vector<float> gravityScale;
+		std::vector<float> damping;
+		std::vector<float> minVelY;
+
+		// write-back targets (valid until the registry changes structurally)
+		std::vector<Transform2D*> transforms;
+		std::vector<HBE::ECS::RigidBody2D*> bodies;
+
+		std::size_t size() const { return posX.size(); }
+		bool empty() const { return posX.empty(); }
+
+		void clear();
+		void reserve(std::size_t n);
+
+		// gather one dynamic body
+		void push(Transform2D& tr, HBE::ECS::RigidBody2D& rb);
+
+		// write positions + velocities back to the components
+		void scatter() const;
+	};
+
+	class RigidBodyIntegrator2D {
+	public:
+		// Semi-implicit Euler step for every body in the set:
+		//   vel += accel * dt; velY += gravityY * gravityScale * dt;
+		//   velY = max(velY, minVelY); vel *= 1 / (1 + damping * dt); pos += vel * dt
+		// Results match the scalar per-entity path bit for bit.
+		static void integrate(RigidBodySoA2D& b, float gravityY, float dt);
+
+		// "AVX", "SSE2" or "Scalar" depending on how this build was compiled
+		static const char* simdPath();
+	};
+
+}
@@ -2,12 +2,26 @@
 
 #include <cstdint>
 #include <functional>
+#include <string>
+#include <vector>
 
 #include "HBE/ECS/Registry.h"
+#include "HBE/ECS/CommandBuffer.h"
+#include "HBE/ECS/SystemScheduler.h"
 #include "HBE/Renderer/RenderItem.h"
 #include "HBE/Renderer/Transform2D.h"
+#include "HBE/Renderer/TransformHierarchy2D.h"
 #include "HBE/Renderer/SpriteAnimationStateMachine.h"
 #include "HBE/ECS/ESCSComponents2D.h"
+#include "HBE/Renderer/RigidBodySoA2D.h"
+#include "HBE/Renderer/StaticColliderGrid2D.h"
+#include "HBE/Renderer/SweepAndPrune2D.h"
+#include "HBE/Renderer/DynamicAABBTree2D.h"
+#include "HBE/Renderer/GridPathfinder2D.h"
+#include "HBE/Renderer/TileCollisionGrid.h"
+#include "HBE/Renderer/TileRectMerger2D.h"
+
+namespace HBE::ECS { struct Collider2D; }
 
 namespace HBE::Renderer {
 
@@ -23,45 +37,190 @@ namespace HBE::Renderer {
         // World-space gravity (negative = down if +Y is up)
         float gravityY = -1800.0f;
 
-        // Sub-stepping helps stability when dt spikes or velocities get high.
-        // 0 disables and uses a single step per frame.
-        int maxSubSteps = 4;
+        // Sub-stepping splits an update whose dt exceeds maxStepDt (at most maxSubSteps
+        // steps). Off by default: driven from a fixed-rate update, each call is already
+        // one integration step. Only worth enabling with a variable or very coarse dt.
+        // With sweptTileCollision, tile-colliding bodies ignore it (one swept move per update).
+        int maxSubSteps = 0;
+
+        // Upper bound per substep (seconds) when sub-stepping is on. Smaller = more stable.
+        float maxStepDt = 1.0f / 60.0f;
+
+        // Tile collision walks every tile a body crosses (TileCollision::moveAndCollideSwept)
+        // instead of sub-stepping the world to avoid tunneling through thin tiles.
+        bool sweptTileCollision = true;
+
+        // Cell size (world units) of the static collider grid used by entity collision.
+        // Around the size of a typical static collider works well.
+        float staticGridCellSize = 128.0f;
+
+        // Push dynamic bodies (non-trigger colliders) out of each other, weighted by mass.
+        bool dynamicCollisions = true;
+
+        // Bodies below sleepVelocity (world units/s, no acceleration) for sleepFrames
+        // updates in a row fall asleep (RigidBody2D::canSleep opts out). Touching bodies
+        // sleep and wake as a group.
+        bool sleeping = true;
+        float sleepVelocity = 5.0f;
+        int sleepFrames = 30;
+    };
+
+    // Per-frame physics counters (filled by Scene2D::update)
+    struct Physics2DStats {
+        int simdBodies = 0;          // integrated through the SoA kernel
+        int tileCollidingBodies = 0; // integrated per entity with tile collision
+        int sweptBodies = 0;         // tile bodies fast enough to cross more than one tile
+        int staticColliders = 0;     // colliders dynamic bodies are pushed out of
+        int staticPairTests = 0;     // dynamic-vs-static overlap tests after the grid broadphase
+        int dynamicBodies = 0;       // bodies in the dynamic-vs-dynamic broadphase
+        int dynamicPairs = 0;        // overlapping pairs it reported
+        int awakeBodies = 0;         // simulated bodies (non-static, unparented)
+        int sleepingBodies = 0;      // skipped until woken
+    };
+
+    struct RaycastHit2D {
+        EntityID entity = InvalidEntityID;
+        float fraction = 1.0f;           // 0..1 along the segment
+        float pointX = 0.0f, pointY = 0.0f;
+        float normalX = 0.0f, normalY = 0.0f; // face that was hit (0,0 if the segment starts inside)
+    };
+
+    struct Ray2D {
+        float x0 = 0.0f, y0 = 0.0f;
+        float x1 = 0.0f, y1 = 0.0f;
+        EntityID ignore = InvalidEntityID; // e.g. the entity doing the line-of-sight check
+    };
 
-        // Upper bound per substep (seconds). Smaller = more stable.
-        float maxStepDt = 1.0f / 120.0f;
+    struct QueryBox2D {
+        float minX = 0.0f, minY = 0.0f;
+        float maxX = 0.0f, maxY = 0.0f;
     };
 
     class Scene2D {
     public:
-        Scene2D() = default;
+        Scene2D();
+
+        // systems capture 'this'
+        Scene2D(const Scene2D&) = delete;
+        Scene2D& operator=(const Scene2D&) = delete;
 
         // Create an entity by copying a template RenderItem
         EntityID createEntity(const RenderItem& templateItem);
 
         // Access
+        // Writes through the returned pointer are picked up by the entity collision
+        // grid on the next update (the entity is flagged as possibly moved).
         Transform2D* getTransform(EntityID id);
 
+        // Static collider moved or resized by a direct registry().get<...>() write
+        // (patch<...>() and getTransform() already flag it). Cheap for non-statics.
+        void markStaticMoved(EntityID id) { m_staticTouched.push_back(id); }
+
+        // Transform hierarchy
+        // Attach 'child' to 'parent' (InvalidEntityID detaches). The child's Transform2D
+        // becomes parent-relative; its current world pose is kept either way.
+        // Fails (false) on invalid entities or if it would create a cycle.
+        // Attached bodies don't simulate: they follow their parent.
+        bool setParent(EntityID child, EntityID parent);
+        EntityID parentOf(EntityID id) const;
+
+        // World transform as of the last update() (the local transform for unparented entities)
+        WorldTransform2D worldTransform(EntityID id) const { return TransformHierarchy2D::worldOf(m_reg, id); }
+        const TransformHierarchy2D& transformHierarchy() const { return m_hierarchy; }
+
         // Sprite animation access (optional per entity)
         // If you call this, the entity will be updated automatically by Scene2D::update().
+        // The returned pointer survives later spawns (stable storage); it is invalidated
+        // when this entity or another animated entity is removed.
         SpriteAnimationStateMachine* addSpriteAnimator(EntityID id, const SpriteRenderer2D::SpriteSheetHandle* sheet);
         SpriteAnimationStateMachine* getSpriteAnimator(EntityID id);
 
         // Physics/tile collision context
         // if set, entities with Transform2D + RigidBody2D + Collider2D will collide against the tile layer
+        // The layer is compiled into a TileCollisionGrid here: call again (or rebuildTileCollision())
+        // after reloading or editing it.
         void setTileCollisionContext(const TileMap* map, const TileMapLayer* collisionLayer);
 
+        // Several collision layers merged into one grid (flags OR-ed per cell)
+        void setTileCollisionLayers(const TileMap* map, const std::vector<const TileMapLayer*>& collisionLayers);
+
+        // recompile the grid from the current layers (e.g. after editing tiles)
+        void rebuildTileCollision();
+
+        // tiles [x0, x1] x [y0, y1] of the collision layers were edited: recompile just
+        // those, re-merge the tile rectangles around them and wake bodies
+        void refreshTiles(int x0, int y0, int x1, int y1);
+
+        const TileCollisionGrid& tileCollisionGrid() const { return m_tileGrid; }
+
+        // Solid tiles merged into rectangles (navigation, lighting, occluders...)
+        const TileRectMerger2D& tileRects() const { return m_tileRects; }
+
+        // Mirror every tile rectangle as a static Collider2D entity (tagged
+        // TileRectColliderComponent, not serialized) so the entity collision path and
+        // scene queries see the level geometry too. Off by default.
+        void setTileRectColliders(bool enabled);
+        bool tileRectColliders() const { return m_tileRectColliders; }
+
+        // Paths and flow fields over the tile collision grid (synced to it here, so
+        // tile edits are picked up on the next call)
+        GridPathfinder2D& pathfinder();
+
         void setCullingEnabled(bool enabled) { m_cullingEnabled = enabled; }
 
         // Physics settings
-        void setPhysics2DSettings(const Physics2DSettings& s) { m_physics = s; }
+        // (wakes every body: gravity etc. may have changed)
+        void setPhysics2DSettings(const Physics2DSettings& s);
         const Physics2DSettings& physics2DSettings() const { return m_physics; }
+        const Physics2DStats& physics2DStats() const { return m_physicsStats; }
 
-        // remove
+        // Sleeping bodies wake by themselves on contact, on a velocity/acceleration write
+        // or a patch<RigidBody2D/Transform2D>(); call this after changing the world in
+        // ways the scene can't see (e.g. editing tiles of the collision layer).
+        void wakeAllBodies();
+
+        // remove (immediate: don't call this while iterating a view, use commands() instead)
         void removeEntity(EntityID id);
 
-        // update animations (call once per frame in your layer)
+        // Deferred structural changes. Scripts (and anything else running inside a
+        // system loop) should spawn/destroy through this; update() flushes it after
+        // the script system and again at the end of the frame.
+        HBE::ECS::CommandBuffer& commands() { return m_commands; }
+
+        // Run the scene systems (call once per frame in your layer).
+        // Scripts run first on the calling thread; physics and animation may run concurrently.
+        // Animation events are delivered to onAnimEvent after all systems finished.
         void update(float dt, const SpriteAnimationStateMachine::EventCallback& onAnimEvent = {});
 
+        // Built-in systems (Scripts, Physics, EntityCollision, Transforms, SceneQueries, Animation) plus any you add.
+        // Per-system timings: systems().stats().
+        HBE::ECS::SystemScheduler& systems() { return m_systems; }
+        const HBE::ECS::SystemScheduler& systems() const { return m_systems; }
+
+        // Scene queries over collider AABBs (Transform2D + Collider2D, triggers included).
+        // Backed by a dynamic AABB tree refit at the end of update(): results reflect the
+        // last update(); colliders added since then aren't found yet, removed ones never are.
+        // Results go into caller buffers; nothing allocates per query.
+        // Closest hit along p0 -> p1.
+        bool raycast(float x0, float y0, float x1, float y1, RaycastHit2D& outHit, EntityID ignore = InvalidEntityID) const;
+        // Entities overlapping the box / containing the point; returns how many were written (<= capacity).
+        std::size_t overlapBox(float minX, float minY, float maxX, float maxY, EntityID* out, std::size_t capacity) const;
+        std::size_t queryPoint(float x, float y, EntityID* out, std::size_t capacity) const;
+
+        // Batches (spread over the job system when it runs). outHits[i] answers rays[i];
+        // box i writes up to capacityPerBox entities at out + i * capacityPerBox and its count to outCounts[i].
+        void raycastBatch(const Ray2D* rays, std::size_t count, RaycastHit2D* outHits) const;
+        void overlapBoxBatch(const QueryBox2D* boxes, std::size_t count, EntityID* out, std::size_t capacityPerBox, std::size_t* outCounts) const;
+
+        // Render interpolation: update() remembers every transform as it was before the
+        // step; render() draws previous -> current blended by alpha (1 = current only).
+        // With a fixed-rate update pass Application::fixedAlpha() every frame.
+        void setRenderAlpha(float alpha) { m_renderAlpha = alpha; }
+        float renderAlpha() const { return m_renderAlpha; }
+
+        // world transform as render() draws it (blended), e.g. for camera follow
+        Transform2D renderTransform(EntityID id) const;
+
         // render all active entities
         void render(Renderer2D& renderer);
 
@@ -76,12 +235,90 @@ namespace HBE::Renderer {
 
     private:
         HBE::ECS::Registry m_reg;
+        HBE::ECS::CommandBuffer m_commands;
+        HBE::ECS::SystemScheduler m_systems;
+
+        // filled by the animation system, drained by update()
+        std::vector<std::string> m_animEvents;
+
+        TransformHierarchy2D m_hierarchy;
+
+        void registerSystems();
+        void connectObservers();
+        void updateScripts(float dt);
+        void updatePhysics(float dt);
+        void resolveDynamicCollisions();
+        void resolveStaticCollisions();
+        void updateSleep();
+        void updateAnimation(float dt);
 
         Physics2DSettings m_physics{};
+        Physics2DStats m_physicsStats{};
+
+        // reused SoA working set for bodies that skip tile collision
+        RigidBodySoA2D m_bodySoA;
+
+        // cached static colliders; observers queue the entities whose Transform2D,
+        // Collider2D, RigidBody2D or Parent changed, and the grid is rebuilt only if
+        // one of them was or now is a static collider
+        bool isStaticCollider(EntityID e) const;
 
-        // optional tile collision pointers (not owned)
+        StaticColliderGrid2D m_staticGrid;
+        std::vector<HBE::ECS::Entity> m_attachedStatics; // parented colliders under static roots, not in the grid
+        std::vector<HBE::ECS::Entity> m_staticTouched;   // pending observer hits
+        std::vector<char> m_staticMember;                // per entity: in the grid or attached at the last build
+        std::uint64_t m_staticsSnapshotLoads = 0;        // restores fire no observers
+        float m_staticsCellSetting = 0.0f;               // staticGridCellSize of the last build (the grid clamps it)
+        bool m_staticsValid = false;
+
+        // dynamic-vs-dynamic working set (slots of m_broadphase index m_dynamicBodies)
+        struct DynamicBody {
+            Transform2D* tr;
+            HBE::ECS::RigidBody2D* rb;
+            const HBE::ECS::Collider2D* col;
+            float invMass;
+        };
+
+        SweepAndPrune2D m_broadphase;
+        std::vector<DynamicBody> m_dynamicBodies;
+        std::vector<SweepAndPrune2D::Pair> m_dynamicPairs;
+
+        // sleep islands over m_dynamicBodies slots (union-find)
+        std::vector<std::uint32_t> m_islandRoot;
+        std::vector<int> m_islandStill;  // per root: fewest still frames among awake members
+        std::vector<char> m_islandWake;  // per root: a member is moving
+
+        // scene query tree: one proxy per Transform2D + Collider2D entity
+        DynamicAABBTree2D m_queryTree;
+        std::vector<int> m_queryProxy;          // entity -> proxy (DynamicAABBTree2D::Null if none)
+        std::vector<std::uint32_t> m_querySeen; // entity -> last sync that visited it
+        std::uint32_t m_queryStamp = 0;
+
+        void syncQueryTree();
+        void removeQueryProxy(EntityID e);
+
+        // world transforms before the last update() (render interpolation), indexed by entity;
+        // valid where m_prevStampOf[e] == m_prevStamp
+        std::vector<Transform2D> m_prevTransforms;
+        std::vector<std::uint32_t> m_prevStampOf;
+        std::uint32_t m_prevStamp = 0;
+        float m_renderAlpha = 1.0f;
+
+        void capturePreviousTransforms();
+
+        // optional tile collision pointers (not owned) and their compiled grid
         const TileMap* m_tileMap = nullptr;
-        const TileMapLayer* m_collisionLayer = nullptr;
+        std::vector<const TileMapLayer*> m_collisionLayers;
+        TileCollisionGrid m_tileGrid;
+
+        TileRectMerger2D m_tileRects;
+        bool m_tileRectColliders = false;
+        std::vector<EntityID> m_tileRectEntities; // by rect id
+
+        void syncTileRectColliders();
+        void destroyTileRectCollider(int rect);
+
+        GridPathfinder2D m_pathfinder;
 
         bool m_cullingEnabled = true;
     };
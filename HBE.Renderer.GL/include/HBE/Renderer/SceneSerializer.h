@@ -4,6 +4,7 @@
 #include <functional>
 
 #include "HBE/Renderer/Scene2D.h"
+#include "HBE/ECS/Prefab.h"
 
 namespace HBE::Renderer {
 
@@ -49,6 +50,15 @@ namespace HBE::Renderer {
             const SceneLoadCallbacks& cb,
             std::string* outTilemapPath = nullptr,
             std::string* outError = nullptr);
+
+        // Loads a prefab: { "name": "...", "components": { ... } } using the same component
+        // blocks as scene entities (Transform2D, Sprite2D, Collider2D, RigidBody2D).
+        // "name" also becomes the instances' TagComponent. Script/Animator are per-entity
+        // bindings and are ignored here; attach them after Registry::instantiate.
+        static bool loadPrefabFromFile(HBE::ECS::Prefab& prefab,
+            const std::string& path,
+            const SceneLoadCallbacks& cb,
+            std::string* outError = nullptr);
     };
 
 }
\ No newline at end of file
@@ -39,6 +39,9 @@ namespace HBE::Renderer {
 		};
 
 		uint32_t m_orderCounter = 0;
+
+		// true while every submit so far arrived in quadLess order
+		bool m_presorted = true;
 		
 		static bool quadLess(const Quad& a, const Quad& b);
 
@@ -66,7 +69,6 @@ namespace HBE::Renderer {
 
 		void emitQuadVertices(const RenderItem& item, float out30[30]) const;
 
-		static bool materialLess(const Quad& a, const Quad& b);
 		void drawRange(const Material* mat, const float* viewProj, const float* verts, int vertexCount);
 	};
 }
\ No newline at end of file
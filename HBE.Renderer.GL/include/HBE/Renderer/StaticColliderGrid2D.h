@@ -0,0 +1,87 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "HBE/ECS/Entity.h"
+
+namespace HBE::Renderer {
+
+	// Uniform grid over static collider AABBs for the entity collision pass.
+	//
+	// Built in one go (add() every box, then build()) into a flat cell table:
+	// cell c owns m_cellItems[m_cellStart[c] .. m_cellStart[c + 1]). A box is listed
+	// in every cell it touches; query() reports it once, from the first cell where
+	// box and query range overlap, so no per-query visited set is needed.
+	// Rebuild it when statics are added, removed or moved; queries never allocate.
+	class StaticColliderGrid2D {
+	public:
+		struct Box {
+			float cx, cy; // center
+			float hx, hy; // half extents
+			HBE::ECS::Entity entity;
+		};
+
+		// Takes effect on the next build(). Capped so the grid stays under maxCells.
+		void setCellSize(float size) { m_cellSize = (size > 0.0f) ? size : 1.0f; }
+		float cellSize() const { return m_cellSize; }
+
+		void clear();
+		void add(HBE::ECS::Entity e, float cx, float cy, float hx, float hy);
+		void build();
+
+		std::size_t boxCount() const { return m_boxes.size(); }
+		std::size_t cellCount() const { return static_cast<std::size_t>(m_cols) * static_cast<std::size_t>(m_rows); }
+		const std::vector<Box>& boxes() const { return m_boxes; }
+
+		// fn(const Box&) for every box whose cells overlap [minX, maxX] x [minY, maxY]
+		// (broadphase: the caller still does the exact overlap test)
+		template<typename Fn>
+		void query(float minX, float minY, float maxX, float maxY, Fn&& fn) const {
+			if (m_boxes.empty()) return;
+
+			int qx0, qy0, qx1, qy1;
+			if (!cellRange(minX, minY, maxX, maxY, qx0, qy0, qx1, qy1)) return;
+
+			for (int y = qy0; y <= qy1; ++y) {
+				for (int x = qx0; x <= qx1; ++x) {
+					const std::size_t c = static_cast<std::size_t>(y) * m_cols + x;
+
+					for (std::uint32_t i = m_cellStart[c]; i < m_cellStart[c + 1]; ++i) {
+						const std::uint32_t bi = m_cellItems[i];
+						const CellRange& r = m_ranges[bi];
+
+						// report only from the first shared cell
+						if (x != (r.x0 > qx0 ? r.x0 : qx0)) continue;
+						if (y != (r.y0 > qy0 ? r.y0 : qy0)) continue;
+
+						fn(m_boxes[bi]);
+					}
+				}
+			}
+		}
+
+		static constexpr std::size_t maxCells = 1u << 20;
+
+	private:
+		struct CellRange {
+			int x0, y0, x1, y1;
+		};
+
+		float m_cellSize = 128.0f;
+		float m_invCell = 1.0f / 128.0f;
+
+		float m_originX = 0.0f, m_originY = 0.0f;
+		int m_cols = 0, m_rows = 0;
+
+		std::vector<Box> m_boxes;
+		std::vector<CellRange> m_ranges;        // parallel to m_boxes
+		std::vector<std::uint32_t> m_cellStart; // cellCount() + 1 offsets
+		std::vector<std::uint32_t> m_cellItems; // box indices
+
+		// clamps to the grid; false if the range misses it entirely
+		bool cellRange(float minX, float minY, float maxX, float maxY, int& x0, int& y0, int& x1, int& y1) const;
+	};
+
+}
@@ -0,0 +1,54 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "HBE/ECS/Entity.h"
+
+namespace HBE::Renderer {
+
+	// Persistent sweep-and-prune broadphase on the X axis for moving bodies.
+	//
+	// Each frame: begin(), add() every body (its slot is the call index), then
+	// findPairs(). The endpoint order is kept from the previous frame and fixed
+	// with an insertion sort, which is close to linear because bodies move little
+	// between frames. Pairs reference slots of the current frame.
+	class SweepAndPrune2D {
+	public:
+		struct Pair {
+			std::uint32_t a, b; // slots, a < b
+		};
+
+		void begin();
+		void add(HBE::ECS::Entity e, float minX, float minY, float maxX, float maxY);
+
+		// overlapping AABB pairs (touching counts) into 'out' (cleared first)
+		void findPairs(std::vector<Pair>& out);
+
+		void clear();
+
+		std::size_t size() const { return m_order.size(); }
+
+		// insertion sort moves during the last findPairs() (0 when nothing changed order)
+		std::size_t lastSortMoves() const { return m_lastSortMoves; }
+
+	private:
+		struct Proxy {
+			float minX, maxX;
+			float minY, maxY;
+			std::uint32_t slot;
+			HBE::ECS::Entity entity;
+		};
+
+		std::vector<Proxy> m_order;   // sorted by minX (persistent)
+		std::vector<Proxy> m_pending; // this frame's adds, in slot order
+		std::vector<Proxy> m_scratch;
+
+		// entity -> pending index + 1 for this frame (0 = not added), sized by the largest entity
+		std::vector<std::uint32_t> m_slotOf;
+
+		std::size_t m_lastSortMoves = 0;
+	};
+
+}
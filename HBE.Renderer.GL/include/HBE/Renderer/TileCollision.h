@@ -1,5 +1,8 @@
 #pragma once
+#include <cstddef>
+
 #include "HBE/Renderer/TileMap.h"
+#include "HBE/Renderer/TileCollisionGrid.h"
 
 namespace HBE::Renderer {
 
@@ -17,6 +20,26 @@ namespace HBE::Renderer {
 		bool ceiling = false;  // hit something while moving up
 
 		bool steppedUp = false; // used step-up during horizontal motion
+
+		// fraction of the axis motion travelled before the hit (1 = no hit on that axis)
+		float timeOfImpactX = 1.0f;
+		float timeOfImpactY = 1.0f;
+
+		bool swept = false; // moveAndCollideSwept: crossed more than one tile on an axis
+	};
+
+	struct TileRay2D {
+		float x0 = 0.0f, y0 = 0.0f;
+		float x1 = 0.0f, y1 = 0.0f;
+	};
+
+	struct TileRaycastHit2D {
+		bool hit = false;
+		int tileX = 0, tileY = 0;
+		float fraction = 1.0f; // 0..1 along the segment
+		float distance = 0.0f; // world units from the start
+		float pointX = 0.0f, pointY = 0.0f;
+		float normalX = 0.0f, normalY = 0.0f; // (0,0) if the segment starts inside the tile
 	};
 
 	class TileCollision {
@@ -27,6 +50,11 @@ namespace HBE::Renderer {
 		static bool isOneWayTile(const TileMap& map, const TileMapLayer& layer, int tx, int ty);
 		static SlopeType slopeTypeAt(const TileMap& map, const TileMapLayer& layer, int tx, int ty);
 
+		// Same queries on a compiled grid
+		static bool isSolidTile(const TileCollisionGrid& grid, int tx, int ty);
+		static bool isOneWayTile(const TileCollisionGrid& grid, int tx, int ty);
+		static SlopeType slopeTypeAt(const TileCollisionGrid& grid, int tx, int ty);
+
 		// Backwards-compatible basic mover (solid tiles only, no one-way/slopes/step-up).
 		static void moveAndCollide(
 			const TileMap& map,
@@ -50,5 +78,61 @@ namespace HBE::Renderer {
 			bool enableSlopes,
 			float oneWayPrevBottom // pass previous bottom world-space Y for correct one-way landing
 		);
+
+		// Same mover on a compiled grid (one byte read per tile instead of tileset lookups).
+		static MoveResult2D moveAndCollideEx(
+			const TileCollisionGrid& grid,
+			AABB& box,
+			float& velX,
+			float& velY,
+			float dt,
+			float maxStepUp,
+			bool enableOneWay,
+			bool enableSlopes,
+			float oneWayPrevBottom
+		);
+
+		// Continuous version of moveAndCollideEx: each axis move walks every tile column/row
+		// the box enters and stops at the first blocking face, so fast bodies can't tunnel
+		// through thin tiles. Per-tile one-way, slope and step-up rules are the ones of
+		// moveAndCollideEx; a move shorter than a tile gives exactly its result, longer
+		// moves cost one column/row test per tile crossed.
+		static MoveResult2D moveAndCollideSwept(
+			const TileMap& map,
+			const TileMapLayer& layer,
+			AABB& box,
+			float& velX,
+			float& velY,
+			float dt,
+			float maxStepUp,
+			bool enableOneWay,
+			bool enableSlopes,
+			float oneWayPrevBottom
+		);
+
+		static MoveResult2D moveAndCollideSwept(
+			const TileCollisionGrid& grid,
+			AABB& box,
+			float& velX,
+			float& velY,
+			float dt,
+			float maxStepUp,
+			bool enableOneWay,
+			bool enableSlopes,
+			float oneWayPrevBottom
+		);
+
+		// First tile hit along p0 -> p1, walking the tiles the segment crosses (exact, corners included).
+		// Solid tiles block from every side, slope tiles are the triangle under their diagonal,
+		// one-way tiles only block segments coming down through their top (if hitOneWay).
+		// Line of sight: !raycast(...).
+		static bool raycast(const TileMap& map, const TileMapLayer& layer, float x0, float y0, float x1, float y1,
+			TileRaycastHit2D& outHit, bool hitOneWay = true);
+		static bool raycast(const TileCollisionGrid& grid, float x0, float y0, float x1, float y1,
+			TileRaycastHit2D& outHit, bool hitOneWay = true);
+
+		// outHits[i] answers rays[i] (spread over the job system when it runs)
+		static void raycastBatch(const TileCollisionGrid& grid, const TileRay2D* rays, std::size_t count,
+			TileRaycastHit2D* outHits, bool hitOneWay = true);
 	};
 }
\ No newline at end of file
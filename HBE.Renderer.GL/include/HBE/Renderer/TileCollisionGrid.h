@@ -0,0 +1,85 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "HBE/Renderer/TileMap.h"
+
+namespace HBE::Renderer {
+
+	// Collision flags of a tile layer compiled into one byte per cell.
+	//
+	// The tileset lookups (solid/one-way sets, slope map) run once per cell at
+	// build time; the movers then read a flat row-major array (bottom-left origin,
+	// like TileMapLayer). Several layers can be merged into one grid: their flags
+	// are OR-ed cell by cell and the grid grows to the largest layer.
+	// Rebuild after loading, hot reloading or editing the source layers.
+	class TileCollisionGrid {
+	public:
+		enum Flags : std::uint8_t {
+			Solid = 1 << 0,
+			OneWay = 1 << 1,
+			SlopeLeftUp = 1 << 2,
+			SlopeRightUp = 1 << 3,
+		};
+
+		static constexpr std::uint8_t SlopeMask = SlopeLeftUp | SlopeRightUp;
+
+		// blocks sideways and upward motion (solid or slope)
+		static constexpr std::uint8_t BlockMask = Solid | SlopeMask;
+
+		// Replace the grid with one layer / add another layer on top.
+		void build(const TileMap& map, const TileMapLayer& layer);
+		void merge(const TileMap& map, const TileMapLayer& layer);
+
+		// Recompute tiles [x0, x1] x [y0, y1] (clamped to the grid) from the layers it was
+		// built from, after editing their data. The grid doesn't grow here.
+		void rebuildRegion(const TileMap& map, const std::vector<const TileMapLayer*>& layers, int x0, int y0, int x1, int y1);
+
+		void clear();
+
+		bool empty() const { return m_cells.empty(); }
+		int width() const { return m_w; }
+		int height() const { return m_h; }
+
+		// world-space tile size (TileMap::worldTileW/H of the last build)
+		float tileW() const { return m_tileW; }
+		float tileH() const { return m_tileH; }
+
+		// bumped by every build/merge/clear (caches keyed on the grid compare this)
+		std::uint64_t version() const { return m_version; }
+
+		// 0 outside the grid
+		std::uint8_t at(int tx, int ty) const {
+			if (tx < 0 || ty < 0 || tx >= m_w || ty >= m_h) return 0;
+			return m_cells[static_cast<std::size_t>(ty) * m_w + tx];
+		}
+
+		bool isSolid(int tx, int ty) const { return (at(tx, ty) & Solid) != 0; }
+		bool isOneWay(int tx, int ty) const { return (at(tx, ty) & OneWay) != 0; }
+		bool blocks(int tx, int ty) const { return (at(tx, ty) & BlockMask) != 0; }
+
+		SlopeType slopeType(int tx, int ty) const { return SlopeOf(at(tx, ty)); }
+
+		static SlopeType SlopeOf(std::uint8_t flags) {
+			if (flags & SlopeLeftUp) return SlopeType::LeftUp;
+			if (flags & SlopeRightUp) return SlopeType::RightUp;
+			return SlopeType::None;
+		}
+
+		// flags of one tile id of 'ts' (0 = empty tile)
+		static std::uint8_t FlagsOf(const TileMapTileset& ts, int tileId);
+
+		const std::vector<std::uint8_t>& cells() const { return m_cells; }
+
+	private:
+		std::vector<std::uint8_t> m_cells;
+		int m_w = 0;
+		int m_h = 0;
+		float m_tileW = 16.0f;
+		float m_tileH = 16.0f;
+		std::uint64_t m_version = 0;
+	};
+
+}
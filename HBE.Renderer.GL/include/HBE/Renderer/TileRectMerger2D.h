@@ -0,0 +1,100 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "HBE/Renderer/TileCollisionGrid.h"
+#include "HBE/Renderer/DynamicAABBTree2D.h"
+
+namespace HBE::Renderer {
+
+	// Tiles of a collision grid (those with any 'mask' flag, solid by default) merged into
+	// axis-aligned rectangles, for systems that want geometry instead of cells
+	// (navigation, lighting, occluders, static colliders).
+	//
+	// Greedy: scanning rows bottom-up, each free tile starts a rectangle that grows right
+	// as far as it can, then up while the whole row span is free. Every tile is owned by
+	// exactly one rectangle. update() only dissolves the rectangles touching the changed
+	// region and re-merges their tiles, so rectangle ids elsewhere stay valid; ids of
+	// removed rectangles are reused. added()/removed() list the ids the last
+	// build()/update() created and dropped (handle removed() first: a reused id is in both).
+	// Greedy isn't minimal, and many small edits fragment the set further; build() re-merges
+	// from scratch when that matters.
+	class TileRectMerger2D {
+	public:
+		struct Rect {
+			int x = 0, y = 0; // bottom-left tile
+			int w = 0, h = 0; // in tiles (0 = free id)
+		};
+
+		static constexpr int None = -1;
+
+		void build(const TileCollisionGrid& grid, std::uint8_t mask = TileCollisionGrid::Solid);
+
+		// tiles [x0, x1] x [y0, y1] changed in 'grid' (same size as at build(), otherwise rebuilds)
+		void update(const TileCollisionGrid& grid, int x0, int y0, int x1, int y1);
+
+		void clear();
+
+		std::size_t rectCount() const { return m_count; }
+
+		// indexable by id; check alive() when walking all of them
+		const std::vector<Rect>& rects() const { return m_rects; }
+		bool alive(int id) const { return id >= 0 && id < (int)m_rects.size() && m_rects[id].w > 0; }
+		const Rect& rect(int id) const { return m_rects[id]; }
+
+		// world-space bounds (tile size of the grid at the last build/update)
+		Bounds2D worldBounds(int id) const;
+
+		// id of the rectangle covering tile (tx, ty), None if not covered
+		int rectAt(int tx, int ty) const {
+			if (tx < 0 || ty < 0 || tx >= m_w || ty >= m_h) return None;
+			return m_owner[static_cast<std::size_t>(ty) * m_w + tx];
+		}
+
+		// fn(id, rect) once for every rectangle overlapping tiles [x0, x1] x [y0, y1]
+		template<typename Fn>
+		void query(int x0, int y0, int x1, int y1, Fn&& fn) const {
+			x0 = x0 < 0 ? 0 : x0;
+			y0 = y0 < 0 ? 0 : y0;
+			x1 = x1 >= m_w ? m_w - 1 : x1;
+			y1 = y1 >= m_h ? m_h - 1 : y1;
+
+			for (int y = y0; y <= y1; ++y) {
+				for (int x = x0; x <= x1; ++x) {
+					const int id = m_owner[static_cast<std::size_t>(y) * m_w + x];
+					if (id == None) continue;
+
+					// report only from the rectangle's first tile inside the range
+					const Rect& r = m_rects[id];
+					if (x != (r.x > x0 ? r.x : x0) || y != (r.y > y0 ? r.y : y0)) continue;
+
+					fn(id, r);
+				}
+			}
+		}
+
+		// changes made by the last build()/update()
+		const std::vector<int>& added() const { return m_added; }
+		const std::vector<int>& removed() const { return m_removed; }
+
+	private:
+		std::vector<Rect> m_rects;
+		std::vector<int> m_freeIds;
+		std::vector<int> m_owner; // per tile, row-major
+		std::size_t m_count = 0;
+
+		int m_w = 0, m_h = 0;
+		float m_tileW = 16.0f, m_tileH = 16.0f;
+		std::uint8_t m_mask = TileCollisionGrid::Solid;
+
+		std::vector<int> m_added;
+		std::vector<int> m_removed;
+
+		bool covered(const TileCollisionGrid& grid, int x, int y) const;
+		void removeRect(int id);
+		void mergeRegion(const TileCollisionGrid& grid, int x0, int y0, int x1, int y1);
+	};
+
+}
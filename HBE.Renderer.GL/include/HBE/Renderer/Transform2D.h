@@ -10,4 +10,14 @@ namespace HBE::Renderer {
         float scaleY = 1.0f;
     };
 
+    // Final transform of an entity that has a Parent (Transform2D is then parent-relative).
+    // Written by the hierarchy pass in Scene2D::update; root entities don't have one.
+    struct WorldTransform2D {
+        float posX = 0.0f;
+        float posY = 0.0f;
+        float rotation = 0.0f;
+        float scaleX = 1.0f;
+        float scaleY = 1.0f;
+    };
+
 }
@@ -0,0 +1,58 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "HBE/ECS/Entity.h"
+#include "HBE/Renderer/Transform2D.h"
+
+namespace HBE::ECS { class Registry; }
+
+namespace HBE::Renderer {
+
+	// Keeps WorldTransform2D of parented entities up to date.
+	//
+	// Every entity in a hierarchy (roots included) gets one node in a flat array
+	// ordered by depth, so parents always come before their children and the pass
+	// is a single forward walk. A node is recomputed only when its local transform
+	// changed or its parent's world transform changed this pass; untouched subtrees
+	// cost one compare per node. The array is rebuilt only when parenting changes.
+	class TransformHierarchy2D {
+	public:
+		// world = parent * local (scale, then rotate, then translate; no shear)
+		static WorldTransform2D compose(const WorldTransform2D& parent, const Transform2D& local);
+
+		// inverse of compose: the local transform that puts a child at 'world' under 'parent'
+		static Transform2D relativeTo(const WorldTransform2D& parent, const WorldTransform2D& world);
+
+		// world transform of any entity: WorldTransform2D if parented, else its Transform2D
+		static WorldTransform2D worldOf(const HBE::ECS::Registry& reg, HBE::ECS::Entity e);
+
+		void propagate(HBE::ECS::Registry& reg);
+
+		// forget the node order (e.g. the registry was replaced)
+		void reset();
+
+		std::size_t nodeCount() const { return m_nodes.size(); }
+		std::size_t updatedLastPass() const { return m_updatedLastPass; }
+
+	private:
+		struct Node {
+			HBE::ECS::Entity entity = HBE::ECS::Null;
+			int parent = -1; // index into m_nodes, -1 for roots
+
+			Transform2D local{};     // local transform the world was computed from
+			WorldTransform2D world{};
+			bool changed = false;    // world recomputed during the current pass
+		};
+
+		std::vector<Node> m_nodes;
+		std::uint64_t m_parentVersion = 0;
+		bool m_valid = false;
+		std::size_t m_updatedLastPass = 0;
+
+		void rebuild(HBE::ECS::Registry& reg);
+	};
+
+}
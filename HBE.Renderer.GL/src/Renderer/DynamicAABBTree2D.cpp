@@ -0,0 +1,313 @@
+#include "HBE/Renderer/DynamicAABBTree2D.h"
+
+#include <algorithm>
+#include <cassert>
+
+namespace HBE::Renderer {
+
+	bool SegmentVsBounds(const Bounds2D& b, float x0, float y0, float dx, float dy, float maxT,
+		float& outT, float& outNx, float& outNy)
+	{
+		float tMin = 0.0f;
+		float tMax = maxT;
+		float nx = 0.0f, ny = 0.0f;
+
+		// X slab
+		if (std::fabs(dx) < 1e-12f) {
+			if (x0 < b.minX || x0 > b.maxX) return false;
+		}
+		else {
+			const float inv = 1.0f / dx;
+			float t1 = (b.minX - x0) * inv;
+			float t2 = (b.maxX - x0) * inv;
+			float n = -1.0f;
+			if (t1 > t2) { std::swap(t1, t2); n = 1.0f; }
+
+			if (t1 > tMin) { tMin = t1; nx = n; ny = 0.0f; }
+			tMax = std::min(tMax, t2);
+			if (tMin > tMax) return false;
+		}
+
+		// Y slab
+		if (std::fabs(dy) < 1e-12f) {
+			if (y0 < b.minY || y0 > b.maxY) return false;
+		}
+		else {
+			const float inv = 1.0f / dy;
+			float t1 = (b.minY - y0) * inv;
+			float t2 = (b.maxY - y0) * inv;
+			float n = -1.0f;
+			if (t1 > t2) { std::swap(t1, t2); n = 1.0f; }
+
+			if (t1 > tMin) { tMin = t1; nx = 0.0f; ny = n; }
+			tMax = std::min(tMax, t2);
+			if (tMin > tMax) return false;
+		}
+
+		outT = tMin;
+		outNx = nx;
+		outNy = ny;
+		return true;
+	}
+
+	int DynamicAABBTree2D::allocateNode() {
+		if (m_freeList == Null) {
+			m_nodes.emplace_back();
+			return static_cast<int>(m_nodes.size()) - 1;
+		}
+
+		const int node = m_freeList;
+		m_freeList = m_nodes[node].parent;
+		m_nodes[node] = Node{};
+		return node;
+	}
+
+	void DynamicAABBTree2D::freeNode(int node) {
+		m_nodes[node].parent = m_freeList;
+		m_nodes[node].height = -1;
+		m_freeList = node;
+	}
+
+	void DynamicAABBTree2D::clear() {
+		m_nodes.clear();
+		m_root = Null;
+		m_freeList = Null;
+		m_proxyCount = 0;
+	}
+
+	int DynamicAABBTree2D::createProxy(const Bounds2D& tight, std::uint32_t userData) {
+		const int proxy = allocateNode();
+		Node& n = m_nodes[proxy];
+		n.tight = tight;
+		n.fat = Bounds2D{ tight.minX - m_margin, tight.minY - m_margin, tight.maxX + m_margin, tight.maxY + m_margin };
+		n.userData = userData;
+		n.height = 0;
+
+		insertLeaf(proxy);
+		++m_proxyCount;
+		return proxy;
+	}
+
+	void DynamicAABBTree2D::destroyProxy(int proxy) {
+		assert(proxy >= 0 && proxy < (int)m_nodes.size() && m_nodes[proxy].isLeaf() && "DynamicAABBTree2D::destroyProxy: not a proxy");
+
+		removeLeaf(proxy);
+		freeNode(proxy);
+		--m_proxyCount;
+	}
+
+	bool DynamicAABBTree2D::moveProxy(int proxy, const Bounds2D& tight) {
+		Node& n = m_nodes[proxy];
+		n.tight = tight;
+
+		if (n.fat.contains(tight)) return false;
+
+		removeLeaf(proxy);
+		m_nodes[proxy].fat = Bounds2D{ tight.minX - m_margin, tight.minY - m_margin, tight.maxX + m_margin, tight.maxY + m_margin };
+		insertLeaf(proxy);
+		return true;
+	}
+
+	void DynamicAABBTree2D::insertLeaf(int leaf) {
+		if (m_root == Null) {
+			m_root = leaf;
+			m_nodes[leaf].parent = Null;
+			return;
+		}
+
+		// descend towards the sibling that grows the tree's total perimeter the least
+		const Bounds2D leafBox = m_nodes[leaf].fat;
+		int index = m_root;
+
+		while (!m_nodes[index].isLeaf()) {
+			const Node& n = m_nodes[index];
+
+			const float area = n.fat.perimeter();
+			const float combinedArea = Bounds2D::merge(n.fat, leafBox).perimeter();
+
+			// cost of making a new parent for this node and the leaf
+			const float cost = 2.0f * combinedArea;
+
+			// minimum cost of pushing the leaf further down
+			const float inheritance = 2.0f * (combinedArea - area);
+
+			auto descendCost = [&](int child) {
+				const Node& c = m_nodes[child];
+				const float merged = Bounds2D::merge(leafBox, c.fat).perimeter();
+				return (c.isLeaf() ? merged : merged - c.fat.perimeter()) + inheritance;
+				};
+
+			const float cost1 = descendCost(n.child1);
+			const float cost2 = descendCost(n.child2);
+
+			if (cost < cost1 && cost < cost2) break;
+
+			index = (cost1 < cost2) ? n.child1 : n.child2;
+		}
+
+		const int sibling = index;
+		const int oldParent = m_nodes[sibling].parent;
+
+		const int newParent = allocateNode();
+		{
+			Node& p = m_nodes[newParent];
+			p.parent = oldParent;
+			p.fat = Bounds2D::merge(leafBox, m_nodes[sibling].fat);
+			p.height = m_nodes[sibling].height + 1;
+			p.child1 = sibling;
+			p.child2 = leaf;
+		}
+
+		if (oldParent != Null) {
+			Node& op = m_nodes[oldParent];
+			if (op.child1 == sibling) op.child1 = newParent;
+			else op.child2 = newParent;
+		}
+		else {
+			m_root = newParent;
+		}
+
+		m_nodes[sibling].parent = newParent;
+		m_nodes[leaf].parent = newParent;
+
+		refitUpwards(m_nodes[leaf].parent);
+	}
+
+	void DynamicAABBTree2D::removeLeaf(int leaf) {
+		if (leaf == m_root) {
+			m_root = Null;
+			return;
+		}
+
+		const int parent = m_nodes[leaf].parent;
+		const int grandParent = m_nodes[parent].parent;
+		const int sibling = (m_nodes[parent].child1 == leaf) ? m_nodes[parent].child2 : m_nodes[parent].child1;
+
+		if (grandParent != Null) {
+			// the sibling takes the parent's place
+			Node& gp = m_nodes[grandParent];
+			if (gp.child1 == parent) gp.child1 = sibling;
+			else gp.child2 = sibling;
+
+			m_nodes[sibling].parent = grandParent;
+			freeNode(parent);
+
+			refitUpwards(grandParent);
+		}
+		else {
+			m_root = sibling;
+			m_nodes[sibling].parent = Null;
+			freeNode(parent);
+		}
+
+		m_nodes[leaf].parent = Null;
+	}
+
+	void DynamicAABBTree2D::refitUpwards(int node) {
+		while (node != Null) {
+			node = balance(node);
+
+			Node& n = m_nodes[node];
+			const Node& c1 = m_nodes[n.child1];
+			const Node& c2 = m_nodes[n.child2];
+
+			n.height = 1 + std::max(c1.height, c2.height);
+			n.fat = Bounds2D::merge(c1.fat, c2.fat);
+
+			node = n.parent;
+		}
+	}
+
+	// Rotate the taller grandchild up if a's children differ in height by more than one.
+	// Returns the node now at a's position.
+	int DynamicAABBTree2D::balance(int iA) {
+		Node& A = m_nodes[iA];
+		if (A.isLeaf() || A.height < 2) return iA;
+
+		const int iB = A.child1;
+		const int iC = A.child2;
+		Node& B = m_nodes[iB];
+		Node& C = m_nodes[iC];
+
+		const int diff = C.height - B.height;
+
+		auto replaceInParent = [&](int oldChild, int newChild, int parent) {
+			if (parent == Null) {
+				m_root = newChild;
+				return;
+			}
+			Node& p = m_nodes[parent];
+			if (p.child1 == oldChild) p.child1 = newChild;
+			else p.child2 = newChild;
+			};
+
+		// C is taller: C moves up
+		if (diff > 1) {
+			const int iF = C.child1;
+			const int iG = C.child2;
+			Node& F = m_nodes[iF];
+			Node& G = m_nodes[iG];
+
+			C.child1 = iA;
+			C.parent = A.parent;
+			A.parent = iC;
+			replaceInParent(iA, iC, C.parent);
+
+			if (F.height > G.height) {
+				C.child2 = iF;
+				A.child2 = iG;
+				G.parent = iA;
+				A.fat = Bounds2D::merge(B.fat, G.fat);
+				C.fat = Bounds2D::merge(A.fat, F.fat);
+				A.height = 1 + std::max(B.height, G.height);
+				C.height = 1 + std::max(A.height, F.height);
+			}
+			else {
+				C.child2 = iG;
+				A.child2 = iF;
+				F.parent = iA;
+				A.fat = Bounds2D::merge(B.fat, F.fat);
+				C.fat = Bounds2D::merge(A.fat, G.fat);
+				A.height = 1 + std::max(B.height, F.height);
+				C.height = 1 + std::max(A.height, G.height);
+			}
+			return iC;
+		}
+
+		// B is taller: B moves up
+		if (diff < -1) {
+			const int iD = B.child1;
+			const int iE = B.child2;
+			Node& D = m_nodes[iD];
+			Node& E = m_nodes[iE];
+
+			B.child1 = iA;
+			B.parent = A.parent;
+			A.parent = iB;
+			replaceInParent(iA, iB, B.parent);
+
+			if (D.height > E.height) {
+				B.child2 = iD;
+				A.child1 = iE;
+				E.parent = iA;
+				A.fat = Bounds2D::merge(C.fat, E.fat);
+				B.fat = Bounds2D::merge(A.fat, D.fat);
+				A.height = 1 + std::max(C.height, E.height);
+				B.height = 1 + std::max(A.height, D.height);
+			}
+			else {
+				B.child2 = iE;
+				A.child1 = iD;
+				D.parent = iA;
+				A.fat = Bounds2D::merge(C.fat, D.fat);
+				B.fat = Bounds2D::merge(A.fat, E.fat);
+				A.height = 1 + std::max(C.height, D.height);
+				B.height = 1 + std::max(A.height, E.height);
+			}
+			return iB;
+		}
+
+		return iA;
+	}
+
+}
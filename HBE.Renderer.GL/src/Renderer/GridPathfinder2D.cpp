@@ -0,0 +1,669 @@
+#include "HBE/Renderer/GridPathfinder2D.h"
+#include "HBE/Core/JobSystem.h"
+#include "HBE/Core/Time.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <functional>
+#include <limits>
+#include <mutex>
+#include <queue>
+#include <utility>
+
+namespace HBE::Renderer {
+
+	namespace {
+		using Clock = std::chrono::steady_clock;
+
+		constexpr float Inf = std::numeric_limits<float>::infinity();
+		constexpr float Sqrt2 = 1.41421356f;
+
+		double MicrosSince(Clock::time_point t0) {
+			return std::chrono::duration<double, std::micro>(Clock::now() - t0).count();
+		}
+
+		int Sign(int v) { return (v > 0) - (v < 0); }
+
+		float Octile(int dx, int dy) {
+			dx = std::abs(dx);
+			dy = std::abs(dy);
+			return (float)std::max(dx, dy) + (Sqrt2 - 1.0f) * (float)std::min(dx, dy);
+		}
+
+		// (f, node) min-heap with lazy deletion
+		using OpenEntry = std::pair<float, int>;
+		using OpenList = std::priority_queue<OpenEntry, std::vector<OpenEntry>, std::greater<OpenEntry>>;
+	}
+
+	// Snapshot of the grid plus the compiled platformer graph. Immutable once built;
+	// searches and flow field jobs share it.
+	struct GridPathfinder2D::NavData {
+		struct Edge {
+			int node = 0; // target (out edges) or source (in edges)
+			float cost = 0.0f;
+			PathMove2D move = PathMove2D::Walk;
+		};
+
+		Settings settings;
+		int w = 0, h = 0;
+		std::uint64_t gridVersion = 0;
+		std::uint64_t generation = 0; // GridPathfinder2D compile count
+		std::vector<std::uint8_t> cells;
+
+		// platformer graph, CSR: edges of node n are [start[n], start[n + 1])
+		std::vector<int> nodeOf; // per tile, -1 if nobody can stand there
+		std::vector<int> tileOf; // per node
+		std::vector<int> outStart, inStart;
+		std::vector<Edge> out, in;
+
+		bool inside(int x, int y) const { return x >= 0 && y >= 0 && x < w && y < h; }
+		int index(int x, int y) const { return y * w + x; }
+		std::uint8_t at(int x, int y) const { return cells[static_cast<std::size_t>(index(x, y))]; }
+
+		// top-down
+		bool walkable(int x, int y) const {
+			return inside(x, y) && (at(x, y) & TileCollisionGrid::BlockMask) == 0;
+		}
+
+		// platformer
+		bool free(int x, int y) const {
+			return inside(x, y) && (at(x, y) & TileCollisionGrid::Solid) == 0;
+		}
+
+		bool slope(int x, int y) const {
+			return inside(x, y) && (at(x, y) & TileCollisionGrid::SlopeMask) != 0;
+		}
+
+		bool supports(int x, int y) const {
+			constexpr std::uint8_t mask = TileCollisionGrid::Solid | TileCollisionGrid::OneWay | TileCollisionGrid::SlopeMask;
+			return inside(x, y) && (at(x, y) & mask) != 0;
+		}
+
+		bool clear(int x, int y0, int y1) const {
+			for (int y = y0; y <= y1; ++y) if (!free(x, y)) return false;
+			return true;
+		}
+
+		bool fits(int x, int y) const { return clear(x, y, y + settings.agentHeight - 1); }
+
+		bool standing(int x, int y) const {
+			return fits(x, y) && (supports(x, y - 1) || slope(x, y));
+		}
+
+		// first standing tile at or below (x, y) falling through free tiles, -1 if none
+		int landing(int x, int y) const {
+			for (; free(x, y); --y) {
+				if (standing(x, y)) return index(x, y);
+			}
+			return -1;
+		}
+
+		void compile(const TileCollisionGrid& grid, const Settings& s);
+		void compileGraph();
+	};
+
+	void GridPathfinder2D::NavData::compile(const TileCollisionGrid& grid, const Settings& s) {
+		settings = s;
+		settings.agentHeight = std::max(settings.agentHeight, 1);
+		w = grid.width();
+		h = grid.height();
+		gridVersion = grid.version();
+		cells = grid.cells();
+
+		if (settings.platformer) compileGraph();
+	}
+
+	void GridPathfinder2D::NavData::compileGraph() {
+		nodeOf.assign(cells.size(), -1);
+		tileOf.clear();
+		for (int y = 0; y < h; ++y) {
+			for (int x = 0; x < w; ++x) {
+				if (!standing(x, y)) continue;
+				nodeOf[index(x, y)] = (int)tileOf.size();
+				tileOf.push_back(index(x, y));
+			}
+		}
+
+		const int ah = settings.agentHeight;
+		outStart.assign(tileOf.size() + 1, 0);
+		out.clear();
+
+		auto addEdge = [&](int tile, float cost, PathMove2D move) {
+			if (tile >= 0 && nodeOf[tile] >= 0) out.push_back(Edge{ nodeOf[tile], cost, move });
+			};
+
+		for (std::size_t n = 0; n < tileOf.size(); ++n) {
+			const int x = tileOf[n] % w;
+			const int y = tileOf[n] / w;
+
+			for (int dir = -1; dir <= 1; dir += 2) {
+				const int nx = x + dir;
+
+				if (standing(nx, y)) {
+					addEdge(index(nx, y), 1.0f, PathMove2D::Walk);
+				}
+				else if (settings.fallOffLedges && fits(nx, y)) {
+					const int land = landing(nx, y - 1);
+					if (land >= 0) addEdge(land, 1.0f + (float)(y - land / w), PathMove2D::Fall);
+				}
+
+				// up and down slopes
+				if (standing(nx, y + 1) && free(x, y + ah) && (slope(x, y) || slope(nx, y + 1) || slope(nx, y))) {
+					addEdge(index(nx, y + 1), Sqrt2, PathMove2D::Walk);
+				}
+				if (standing(nx, y - 1) && fits(nx, y) && (slope(x, y) || slope(nx, y - 1) || slope(x, y - 1))) {
+					addEdge(index(nx, y - 1), Sqrt2, PathMove2D::Walk);
+				}
+			}
+
+			if (settings.dropThroughOneWay && y > 0) {
+				const std::uint8_t below = at(x, y - 1);
+				if ((below & TileCollisionGrid::OneWay) && !(below & TileCollisionGrid::BlockMask)) {
+					const int land = landing(x, y - 1);
+					if (land >= 0) addEdge(land, (float)(y - land / w), PathMove2D::Drop);
+				}
+			}
+
+			// Jumps: the arc peaks one tile above the higher end. The start and landing
+			// columns must be free from their tile up to the peak (plus the agent), the
+			// columns in between from the higher end up.
+			if (settings.maxJumpHeight > 0) {
+				for (int dx = 0; dx <= settings.maxJumpDistance; ++dx) {
+					for (int dir = -1; dir <= (dx == 0 ? -1 : 1); dir += 2) {
+						const int tx = x + dir * dx;
+
+						for (int dy = -settings.maxJumpHeight; dy <= settings.maxJumpHeight; ++dy) {
+							if ((dx == 0 && dy <= 0) || (dx == 1 && dy == 0)) continue; // not a jump
+							const int ty = y + dy;
+							if (!standing(tx, ty)) continue;
+
+							const int top = std::max(y, ty) + ah;
+							bool ok = clear(x, y, top) && clear(tx, ty, top);
+							for (int c = 1; c < dx && ok; ++c) ok = clear(x + dir * c, std::max(y, ty), top);
+							if (!ok) continue;
+
+							addEdge(index(tx, ty), (float)(dx + std::abs(dy)) + settings.jumpCost, PathMove2D::Jump);
+						}
+					}
+				}
+			}
+
+			outStart[n + 1] = (int)out.size();
+		}
+
+		// reversed edges, for searches from the goal
+		inStart.assign(tileOf.size() + 1, 0);
+		for (const Edge& e : out) ++inStart[e.node + 1];
+		for (std::size_t n = 0; n < tileOf.size(); ++n) inStart[n + 1] += inStart[n];
+
+		in.assign(out.size(), Edge{});
+		std::vector<int> fill(inStart.begin(), inStart.end() - 1);
+		for (std::size_t n = 0; n < tileOf.size(); ++n) {
+			for (int i = outStart[n]; i < outStart[n + 1]; ++i) {
+				const Edge& e = out[i];
+				in[fill[e.node]++] = Edge{ (int)n, e.cost, e.move };
+			}
+		}
+	}
+
+	namespace {
+		// Jump Point Search, no corner cutting: a diagonal step needs both orthogonal
+		// neighbours free, and forced neighbours come from walls beside straight runs.
+		template<typename Nav>
+		int JumpStraight(const Nav& nav, int x, int y, int dx, int dy, int goal) {
+			for (;;) {
+				x += dx;
+				y += dy;
+				if (!nav.walkable(x, y)) return -1;
+
+				const int i = nav.index(x, y);
+				if (i == goal) return i;
+
+				if (dx != 0) {
+					if ((nav.walkable(x, y - 1) && !nav.walkable(x - dx, y - 1)) ||
+						(nav.walkable(x, y + 1) && !nav.walkable(x - dx, y + 1))) return i;
+				}
+				else {
+					if ((nav.walkable(x - 1, y) && !nav.walkable(x - 1, y - dy)) ||
+						(nav.walkable(x + 1, y) && !nav.walkable(x + 1, y - dy))) return i;
+				}
+			}
+		}
+
+		template<typename Nav>
+		int JumpDiagonal(const Nav& nav, int x, int y, int dx, int dy, int goal) {
+			for (;;) {
+				if (!nav.walkable(x + dx, y) || !nav.walkable(x, y + dy)) return -1;
+
+				x += dx;
+				y += dy;
+				if (!nav.walkable(x, y)) return -1;
+
+				const int i = nav.index(x, y);
+				if (i == goal) return i;
+
+				if (JumpStraight(nav, x, y, dx, 0, goal) >= 0 || JumpStraight(nav, x, y, 0, dy, goal) >= 0) return i;
+			}
+		}
+
+		// directions worth following from (x, y) when arriving from 'parent' (-1 = start)
+		template<typename Nav>
+		int PrunedDirections(const Nav& nav, int x, int y, int parent, int (&dirs)[8][2]) {
+			int n = 0;
+			auto push = [&](int dx, int dy) { dirs[n][0] = dx; dirs[n][1] = dy; ++n; };
+			auto open = [&](int dx, int dy) { return nav.walkable(x + dx, y + dy); };
+
+			if (parent < 0) {
+				for (int dy = -1; dy <= 1; ++dy) {
+					for (int dx = -1; dx <= 1; ++dx) {
+						if (dx == 0 && dy == 0) continue;
+						if (dx != 0 && dy != 0 && !(open(dx, 0) && open(0, dy))) continue;
+						if (open(dx, dy)) push(dx, dy);
+					}
+				}
+				return n;
+			}
+
+			const int dx = Sign(x - parent % nav.w);
+			const int dy = Sign(y - parent / nav.w);
+
+			if (dx != 0 && dy != 0) {
+				if (open(0, dy)) push(0, dy);
+				if (open(dx, 0)) push(dx, 0);
+				if (open(0, dy) && open(dx, 0)) push(dx, dy);
+			}
+			else if (dx != 0) {
+				const bool up = open(0, 1), down = open(0, -1);
+				if (open(dx, 0)) {
+					push(dx, 0);
+					if (up) push(dx, 1);
+					if (down) push(dx, -1);
+				}
+				if (up) push(0, 1);
+				if (down) push(0, -1);
+			}
+			else {
+				const bool right = open(1, 0), left = open(-1, 0);
+				if (open(0, dy)) {
+					push(0, dy);
+					if (right) push(1, dy);
+					if (left) push(-1, dy);
+				}
+				if (right) push(1, 0);
+				if (left) push(-1, 0);
+			}
+			return n;
+		}
+	}
+
+	// ---- FlowField2D ----
+
+	bool FlowField2D::next(int tx, int ty, int& outX, int& outY) const {
+		if (tx < 0 || ty < 0 || tx >= m_w || ty >= m_h) return false;
+
+		const int n = m_next[static_cast<std::size_t>(ty) * m_w + tx];
+		if (n < 0) return false;
+
+		outX = n % m_w;
+		outY = n / m_w;
+		return true;
+	}
+
+	PathMove2D FlowField2D::move(int tx, int ty) const {
+		if (m_move.empty() || tx < 0 || ty < 0 || tx >= m_w || ty >= m_h) return PathMove2D::Walk;
+		return m_move[static_cast<std::size_t>(ty) * m_w + tx];
+	}
+
+	void FlowField2D::direction(int tx, int ty, float& outX, float& outY) const {
+		outX = 0.0f;
+		outY = 0.0f;
+
+		int nx, ny;
+		if (!next(tx, ty, nx, ny)) return;
+
+		const float dx = (float)(nx - tx);
+		const float dy = (float)(ny - ty);
+		const float len = std::sqrt(dx * dx + dy * dy);
+		outX = dx / len;
+		outY = dy / len;
+	}
+
+	// ---- GridPathfinder2D ----
+
+	struct GridPathfinder2D::FieldSlot {
+		int goal = -1;
+		std::uint64_t lastRequest = 0;
+
+		std::mutex mutex;
+		std::shared_ptr<const FlowField2D> field;
+		std::uint64_t fieldGeneration = 0; // NavData::generation the field was built from
+		bool pending = false;
+
+		HBE::Core::JobHandle job;
+	};
+
+	GridPathfinder2D::GridPathfinder2D() = default;
+	GridPathfinder2D::~GridPathfinder2D() = default; // running jobs own what they use
+
+	void GridPathfinder2D::setSettings(const Settings& settings) {
+		m_settings = settings;
+		m_dirty = true;
+	}
+
+	void GridPathfinder2D::sync(const TileCollisionGrid& grid) {
+		if (!m_dirty && m_nav && m_source == &grid && m_sourceVersion == grid.version()) return;
+
+		auto nav = std::make_shared<NavData>();
+		nav->compile(grid, m_settings);
+		nav->generation = ++m_generation;
+		m_nav = std::move(nav);
+
+		m_source = &grid;
+		m_sourceVersion = grid.version();
+		m_dirty = false;
+	}
+
+	PathResult2D GridPathfinder2D::findPath(int startX, int startY, int goalX, int goalY) const {
+		const auto t0 = Clock::now();
+
+		PathResult2D result;
+		auto finish = [&]() {
+			result.computeMicros = MicrosSince(t0);
+			result.producedAt = HBE::Core::GetTimeSeconds();
+			return result;
+			};
+
+		if (!m_nav) return finish();
+		const NavData& nav = *m_nav;
+		result.gridVersion = nav.gridVersion;
+
+		if (nav.settings.platformer) {
+			const int startTile = nav.inside(startX, startY) ? nav.landing(startX, startY) : -1;
+			const int goalTile = nav.inside(goalX, goalY) ? nav.landing(goalX, goalY) : -1;
+			if (startTile < 0 || goalTile < 0) return finish();
+
+			const int start = nav.nodeOf[startTile];
+			const int goal = nav.nodeOf[goalTile];
+			const int gx = goalTile % nav.w, gy = goalTile / nav.w;
+
+			// every edge costs at least its larger axis, so Chebyshev distance is admissible
+			auto heuristic = [&](int node) {
+				const int t = nav.tileOf[node];
+				return (float)std::max(std::abs(t % nav.w - gx), std::abs(t / nav.w - gy));
+				};
+
+			std::vector<float> g(nav.tileOf.size(), Inf);
+			std::vector<int> parent(nav.tileOf.size(), -1);
+			std::vector<PathMove2D> via(nav.tileOf.size(), PathMove2D::Walk);
+
+			OpenList open;
+			g[start] = 0.0f;
+			open.push({ heuristic(start), start });
+
+			while (!open.empty()) {
+				const auto [f, n] = open.top();
+				open.pop();
+				if (f > g[n] + heuristic(n)) continue; // stale entry
+
+				++result.expanded;
+				if (n == goal) break;
+
+				for (int i = nav.outStart[n]; i < nav.outStart[n + 1]; ++i) {
+					const NavData::Edge& e = nav.out[i];
+					const float ng = g[n] + e.cost;
+					if (ng >= g[e.node]) continue;
+
+					g[e.node] = ng;
+					parent[e.node] = n;
+					via[e.node] = e.move;
+					open.push({ ng + heuristic(e.node), e.node });
+				}
+			}
+
+			if (g[goal] == Inf) return finish();
+
+			for (int n = goal; n >= 0; n = parent[n]) {
+				const int t = nav.tileOf[n];
+				result.tiles.push_back(PathTile2D{ t % nav.w, t / nav.w });
+				result.moves.push_back(via[n]);
+			}
+			std::reverse(result.tiles.begin(), result.tiles.end());
+			std::reverse(result.moves.begin(), result.moves.end());
+			result.cost = g[goal];
+			result.found = true;
+			return finish();
+		}
+
+		if (!nav.walkable(startX, startY) || !nav.walkable(goalX, goalY)) return finish();
+
+		const int start = nav.index(startX, startY);
+		const int goal = nav.index(goalX, goalY);
+
+		std::vector<float> g(nav.cells.size(), Inf);
+		std::vector<int> parent(nav.cells.size(), -1);
+
+		auto heuristic = [&](int i) {
+			return nav.settings.diagonal
+				? Octile(i % nav.w - goalX, i / nav.w - goalY)
+				: (float)(std::abs(i % nav.w - goalX) + std::abs(i / nav.w - goalY));
+			};
+
+		OpenList open;
+		g[start] = 0.0f;
+		open.push({ heuristic(start), start });
+
+		while (!open.empty()) {
+			const auto [f, n] = open.top();
+			open.pop();
+			if (f > g[n] + heuristic(n)) continue;
+
+			++result.expanded;
+			if (n == goal) break;
+
+			const int x = n % nav.w;
+			const int y = n / nav.w;
+
+			auto relax = [&](int to) {
+				const float ng = g[n] + Octile(to % nav.w - x, to / nav.w - y);
+				if (ng >= g[to]) return;
+
+				g[to] = ng;
+				parent[to] = n;
+				open.push({ ng + heuristic(to), to });
+				};
+
+			if (nav.settings.diagonal) {
+				int dirs[8][2];
+				const int count = PrunedDirections(nav, x, y, parent[n], dirs);
+				for (int d = 0; d < count; ++d) {
+					const int dx = dirs[d][0], dy = dirs[d][1];
+					const int jp = (dx != 0 && dy != 0)
+						? JumpDiagonal(nav, x, y, dx, dy, goal)
+						: JumpStraight(nav, x, y, dx, dy, goal);
+					if (jp >= 0) relax(jp);
+				}
+			}
+			else {
+				static constexpr int steps[4][2] = { { 1, 0 }, { -1, 0 }, { 0, 1 }, { 0, -1 } };
+				for (const auto& s : steps) {
+					if (nav.walkable(x + s[0], y + s[1])) relax(nav.index(x + s[0], y + s[1]));
+				}
+			}
+		}
+
+		if (g[goal] == Inf) return finish();
+
+		for (int n = goal; n >= 0; n = parent[n]) result.tiles.push_back(PathTile2D{ n % nav.w, n / nav.w });
+		std::reverse(result.tiles.begin(), result.tiles.end());
+		result.moves.assign(result.tiles.size(), PathMove2D::Walk);
+		result.cost = g[goal];
+		result.found = true;
+		return finish();
+	}
+
+	std::shared_ptr<FlowField2D> GridPathfinder2D::ComputeFlowField(const NavData& nav, int goal) {
+		const auto t0 = Clock::now();
+
+		auto field = std::make_shared<FlowField2D>();
+		field->m_goalX = goal % nav.w;
+		field->m_goalY = goal / nav.w;
+		field->m_w = nav.w;
+		field->m_h = nav.h;
+		field->m_gridVersion = nav.gridVersion;
+		field->m_dist.assign(nav.cells.size(), Inf);
+		field->m_next.assign(nav.cells.size(), -1);
+
+		std::vector<float>& dist = field->m_dist;
+		OpenList open;
+
+		if (nav.settings.platformer) {
+			field->m_move.assign(nav.cells.size(), PathMove2D::Walk);
+
+			// Dijkstra from the goal over the reversed edges
+			dist[goal] = 0.0f;
+			open.push({ 0.0f, nav.nodeOf[goal] });
+
+			while (!open.empty()) {
+				const auto [d, n] = open.top();
+				open.pop();
+				if (d > dist[nav.tileOf[n]]) continue;
+
+				for (int i = nav.inStart[n]; i < nav.inStart[n + 1]; ++i) {
+					const NavData::Edge& e = nav.in[i];
+					const int from = nav.tileOf[e.node];
+					const float nd = d + e.cost;
+					if (nd >= dist[from]) continue;
+
+					dist[from] = nd;
+					field->m_next[from] = nav.tileOf[n];
+					field->m_move[from] = e.move;
+					open.push({ nd, e.node });
+				}
+			}
+		}
+		else {
+			// moves are symmetric: Dijkstra from the goal over the grid itself
+			dist[goal] = 0.0f;
+			open.push({ 0.0f, goal });
+
+			while (!open.empty()) {
+				const auto [d, n] = open.top();
+				open.pop();
+				if (d > dist[n]) continue;
+
+				const int x = n % nav.w;
+				const int y = n / nav.w;
+
+				for (int dy = -1; dy <= 1; ++dy) {
+					for (int dx = -1; dx <= 1; ++dx) {
+						if (dx == 0 && dy == 0) continue;
+						const bool diagonal = dx != 0 && dy != 0;
+						if (diagonal && !(nav.settings.diagonal && nav.walkable(x + dx, y) && nav.walkable(x, y + dy))) continue;
+						if (!nav.walkable(x + dx, y + dy)) continue;
+
+						const int to = nav.index(x + dx, y + dy);
+						const float nd = d + (diagonal ? Sqrt2 : 1.0f);
+						if (nd >= dist[to]) continue;
+
+						dist[to] = nd;
+						field->m_next[to] = n;
+						open.push({ nd, to });
+					}
+				}
+			}
+		}
+
+		for (float& d : dist) if (d == Inf) d = -1.0f;
+
+		field->m_computeMicros = MicrosSince(t0);
+		field->m_producedAt = HBE::Core::GetTimeSeconds();
+		return field;
+	}
+
+	std::shared_ptr<const FlowField2D> GridPathfinder2D::flowField(int goalX, int goalY) {
+		if (!m_nav || !m_nav->inside(goalX, goalY)) return nullptr;
+
+		int goal = m_nav->index(goalX, goalY);
+		if (m_nav->settings.platformer) {
+			goal = m_nav->landing(goalX, goalY);
+			if (goal < 0) return nullptr;
+		}
+		else if (!m_nav->walkable(goalX, goalY)) {
+			return nullptr;
+		}
+
+		std::shared_ptr<FieldSlot> slot;
+		for (const auto& s : m_fields) {
+			if (s->goal == goal) { slot = s; break; }
+		}
+
+		if (!slot) {
+			if (m_fields.size() >= std::max<std::size_t>(m_settings.maxFlowFields, 1)) {
+				// a job still running on the evicted slot keeps it alive until it ends
+				auto oldest = std::min_element(m_fields.begin(), m_fields.end(),
+					[](const auto& a, const auto& b) { return a->lastRequest < b->lastRequest; });
+				m_fields.erase(oldest);
+			}
+
+			slot = std::make_shared<FieldSlot>();
+			slot->goal = goal;
+			m_fields.push_back(slot);
+		}
+		slot->lastRequest = ++m_requestClock;
+
+		std::shared_ptr<const FlowField2D> field;
+		bool schedule = false;
+		{
+			std::lock_guard<std::mutex> lock(slot->mutex);
+			field = slot->field;
+
+			schedule = !slot->pending && (!field || slot->fieldGeneration != m_nav->generation);
+			if (schedule) slot->pending = true;
+		}
+
+		if (schedule) {
+			std::shared_ptr<const NavData> nav = m_nav;
+			auto job = [slot, nav, goal]() {
+				auto result = ComputeFlowField(*nav, goal);
+
+				std::lock_guard<std::mutex> lock(slot->mutex);
+				slot->field = std::move(result);
+				slot->fieldGeneration = nav->generation;
+				slot->pending = false;
+				};
+
+			if (auto* jobs = HBE::Core::JobSystem::Get()) {
+				slot->job = jobs->schedule(std::move(job));
+			}
+			else {
+				job();
+			}
+
+			// finished inline (no job system, or it ran the job on this thread)
+			std::lock_guard<std::mutex> lock(slot->mutex);
+			field = slot->field;
+		}
+
+		return field;
+	}
+
+	void GridPathfinder2D::waitFlowFields() {
+		auto* jobs = HBE::Core::JobSystem::Get();
+		if (!jobs) return;
+
+		for (const auto& slot : m_fields) {
+			if (slot->job.valid()) jobs->wait(slot->job);
+		}
+	}
+
+	std::size_t GridPathfinder2D::pendingFlowFields() const {
+		std::size_t n = 0;
+		for (const auto& slot : m_fields) {
+			std::lock_guard<std::mutex> lock(slot->mutex);
+			if (slot->pending) ++n;
+		}
+		return n;
+	}
+
+}
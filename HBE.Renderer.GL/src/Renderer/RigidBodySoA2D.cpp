@@ -0,0 +1,151 @@
+#include "HBE/Renderer/RigidBodySoA2D.h"
+#include "HBE/Renderer/Transform2D.h"
+#include "HBE/ECS/Components.h"
+
+#include <algorithm>
+#include <limits>
+
+#if defined(__AVX__)
+#define HBE_RB_SIMD_AVX 1
+#include <immintrin.h>
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define HBE_RB_SIMD_SSE2 1
+#include <emmintrin.h>
+#endif
+
+namespace HBE::Renderer {
+
+	void RigidBodySoA2D::clear() {
+		posX.clear(); posY.clear();
+		velX.clear(); velY.clear();
+		accelX.clear(); accelY.clear();
+		gravityScale.clear();
+		damping.clear();
+		minVelY.clear();
+		transforms.clear();
+		bodies.clear();
+	}
+
+	void RigidBodySoA2D::reserve(std::size_t n) {
+		posX.reserve(n); posY.reserve(n);
+		velX.reserve(n); velY.reserve(n);
+		accelX.reserve(n); accelY.reserve(n);
+		gravityScale.reserve(n);
+		damping.reserve(n);
+		minVelY.reserve(n);
+		transforms.reserve(n);
+		bodies.reserve(n);
+	}
+
+	void RigidBodySoA2D::push(Transform2D& tr, HBE::ECS::RigidBody2D& rb) {
+		posX.push_back(tr.posX);
+		posY.push_back(tr.posY);
+		velX.push_back(rb.velX);
+		velY.push_back(rb.velY);
+		accelX.push_back(rb.accelX);
+		accelY.push_back(rb.accelY);
+		gravityScale.push_back(rb.useGravity ? rb.gravityScale : 0.0f);
+		damping.push_back(std::max(0.0f, rb.linearDamping));
+		minVelY.push_back(rb.maxFallSpeed != 0.0f ? rb.maxFallSpeed : -std::numeric_limits<float>::infinity());
+		transforms.push_back(&tr);
+		bodies.push_back(&rb);
+	}
+
+	void RigidBodySoA2D::scatter() const {
+		const std::size_t n = size();
+		for (std::size_t i = 0; i < n; ++i) {
+			transforms[i]->posX = posX[i];
+			transforms[i]->posY = posY[i];
+			bodies[i]->velX = velX[i];
+			bodies[i]->velY = velY[i];
+		}
+	}
+
+	static void integrateScalar(RigidBodySoA2D& b, float gravityY, float dt, std::size_t begin, std::size_t end) {
+		for (std::size_t i = begin; i < end; ++i) {
+			float vx = b.velX[i] + b.accelX[i] * dt;
+			float vy = b.velY[i] + b.accelY[i] * dt;
+
+			vy += gravityY * b.gravityScale[i] * dt;
+			vy = std::max(vy, b.minVelY[i]);
+
+			const float k = 1.0f / (1.0f + b.damping[i] * dt);
+			vx *= k;
+			vy *= k;
+
+			b.velX[i] = vx;
+			b.velY[i] = vy;
+			b.posX[i] += vx * dt;
+			b.posY[i] += vy * dt;
+		}
+	}
+
+	void RigidBodyIntegrator2D::integrate(RigidBodySoA2D& b, float gravityY, float dt) {
+		const std::size_t n = b.size();
+		std::size_t i = 0;
+
+#if defined(HBE_RB_SIMD_AVX)
+		const __m256 vDt = _mm256_set1_ps(dt);
+		const __m256 vG = _mm256_set1_ps(gravityY);
+		const __m256 vOne = _mm256_set1_ps(1.0f);
+
+		for (; i + 8 <= n; i += 8) {
+			__m256 vx = _mm256_loadu_ps(&b.velX[i]);
+			__m256 vy = _mm256_loadu_ps(&b.velY[i]);
+
+			vx = _mm256_add_ps(vx, _mm256_mul_ps(_mm256_loadu_ps(&b.accelX[i]), vDt));
+			vy = _mm256_add_ps(vy, _mm256_mul_ps(_mm256_loadu_ps(&b.accelY[i]), vDt));
+
+			vy = _mm256_add_ps(vy, _mm256_mul_ps(_mm256_mul_ps(vG, _mm256_loadu_ps(&b.gravityScale[i])), vDt));
+			vy = _mm256_max_ps(vy, _mm256_loadu_ps(&b.minVelY[i]));
+
+			const __m256 k = _mm256_div_ps(vOne, _mm256_add_ps(vOne, _mm256_mul_ps(_mm256_loadu_ps(&b.damping[i]), vDt)));
+			vx = _mm256_mul_ps(vx, k);
+			vy = _mm256_mul_ps(vy, k);
+
+			_mm256_storeu_ps(&b.velX[i], vx);
+			_mm256_storeu_ps(&b.velY[i], vy);
+			_mm256_storeu_ps(&b.posX[i], _mm256_add_ps(_mm256_loadu_ps(&b.posX[i]), _mm256_mul_ps(vx, vDt)));
+			_mm256_storeu_ps(&b.posY[i], _mm256_add_ps(_mm256_loadu_ps(&b.posY[i]), _mm256_mul_ps(vy, vDt)));
+		}
+#elif defined(HBE_RB_SIMD_SSE2)
+		const __m128 vDt = _mm_set1_ps(dt);
+		const __m128 vG = _mm_set1_ps(gravityY);
+		const __m128 vOne = _mm_set1_ps(1.0f);
+
+		for (; i + 4 <= n; i += 4) {
+			__m128 vx = _mm_loadu_ps(&b.velX[i]);
+			__m128 vy = _mm_loadu_ps(&b.velY[i]);
+
+			vx = _mm_add_ps(vx, _mm_mul_ps(_mm_loadu_ps(&b.accelX[i]), vDt));
+			vy = _mm_add_ps(vy, _mm_mul_ps(_mm_loadu_ps(&b.accelY[i]), vDt));
+
+			vy = _mm_add_ps(vy, _mm_mul_ps(_mm_mul_ps(vG, _mm_loadu_ps(&b.gravityScale[i])), vDt));
+			vy = _mm_max_ps(vy, _mm_loadu_ps(&b.minVelY[i]));
+
+			const __m128 k = _mm_div_ps(vOne, _mm_add_ps(vOne, _mm_mul_ps(_mm_loadu_ps(&b.damping[i]), vDt)));
+			vx = _mm_mul_ps(vx, k);
+			vy = _mm_mul_ps(vy, k);
+
+			_mm_storeu_ps(&b.velX[i], vx);
+			_mm_storeu_ps(&b.velY[i], vy);
+			_mm_storeu_ps(&b.posX[i], _mm_add_ps(_mm_loadu_ps(&b.posX[i]), _mm_mul_ps(vx, vDt)));
+			_mm_storeu_ps(&b.posY[i], _mm_add_ps(_mm_loadu_ps(&b.posY[i]), _mm_mul_ps(vy, vDt)));
+		}
+#endif
+
+		// remainder (and the whole set on non-SIMD builds)
+		integrateScalar(b, gravityY, dt, i, n);
+	}
+
+	const char* RigidBodyIntegrator2D::simdPath() {
+#if defined(HBE_RB_SIMD_AVX)
+		return "AVX";
+#elif defined(HBE_RB_SIMD_SSE2)
+		return "SSE2";
+#else
+		return "Scalar";
+#endif
+	}
+
+}
@@ -9,6 +9,10 @@
 
 #include "HBE/Renderer/TileMap.h"
 #include "HBE/Renderer/TileCollision.h"
+#include "HBE/Renderer/RigidBodySoA2D.h"
+#include "HBE/Renderer/StaticColliderGrid2D.h"
+#include "HBE/Renderer/SweepAndPrune2D.h"
+#include "HBE/Core/JobSystem.h"
 
 #include <cmath>
 #include <cstring>
@@ -19,6 +23,42 @@ namespace HBE::Renderer {
 
     using HBE::Core::LogError;
 
+    Scene2D::Scene2D() {
+        registerSystems();
+        connectObservers();
+    }
+
+    void Scene2D::registerSystems() {
+        using HBE::ECS::SystemAccess;
+
+        // Scripts run game code that may touch anything, so they run alone.
+        m_systems.add("Scripts", SystemAccess{}.exclusive(),
+            [this](HBE::ECS::Registry&, float dt) { updateScripts(dt); });
+
+        m_systems.add("Physics", SystemAccess{}.read<HBE::ECS::Collider2D, HBE::ECS::Parent>().write<Transform2D, HBE::ECS::RigidBody2D>(),
+            [this](HBE::ECS::Registry&, float dt) { updatePhysics(dt); });
+
+        m_systems.add("EntityCollision", SystemAccess{}.read<HBE::ECS::Collider2D, HBE::ECS::Parent, WorldTransform2D>().write<Transform2D, HBE::ECS::RigidBody2D>(),
+            [this](HBE::ECS::Registry&, float) {
+                // statics last: they win over pushes between bodies
+                resolveDynamicCollisions();
+                resolveStaticCollisions();
+                updateSleep();
+            });
+
+        // After collision so children follow where their parents ended up this frame.
+        m_systems.add("Transforms", SystemAccess{}.read<Transform2D, HBE::ECS::Parent, HBE::ECS::Children>().write<WorldTransform2D>(),
+            [this](HBE::ECS::Registry& reg, float) { m_hierarchy.propagate(reg); });
+
+        // Final positions of the frame -> query tree (raycast/overlapBox/queryPoint).
+        m_systems.add("SceneQueries", SystemAccess{}.read<Transform2D, HBE::ECS::Collider2D, WorldTransform2D>(),
+            [this](HBE::ECS::Registry&, float) { syncQueryTree(); });
+
+        // Doesn't touch bodies: runs alongside physics.
+        m_systems.add("Animation", SystemAccess{}.write<AnimationComponent2D, SpriteComponent2D>(),
+            [this](HBE::ECS::Registry&, float dt) { updateAnimation(dt); });
+    }
+
     EntityID Scene2D::createEntity(const RenderItem& templateItem) {
         EntityID e = m_reg.create();
 
@@ -58,9 +98,125 @@ namespace HBE::Renderer {
     Transform2D* Scene2D::getTransform(EntityID id) {
         if (!m_reg.valid(id)) return nullptr;
         if (!m_reg.has<Transform2D>(id)) return nullptr;
+        m_staticTouched.push_back(id); // the caller may move a static through it
         return &m_reg.get<Transform2D>(id);
     }
 
+    // Turn a child back into a root without moving it: its local transform becomes its world transform.
+    static void detachKeepWorld(HBE::ECS::Registry& reg, HBE::ECS::Entity child) {
+        if (!reg.valid(child)) return;
+
+        if (reg.has<WorldTransform2D>(child) && reg.has<Transform2D>(child)) {
+            const WorldTransform2D w = reg.get<WorldTransform2D>(child);
+            reg.patch<Transform2D>(child, [&](Transform2D& t) {
+                t.posX = w.posX;
+                t.posY = w.posY;
+                t.rotation = w.rotation;
+                t.scaleX = w.scaleX;
+                t.scaleY = w.scaleY;
+                });
+        }
+
+        reg.remove<WorldTransform2D>(child);
+        reg.remove<HBE::ECS::Parent>(child); // observer drops it from the parent's list
+    }
+
+    static inline void wakeBody(HBE::ECS::RigidBody2D& rb) {
+        rb.sleeping = false;
+        rb.stillFrames = 0;
+    }
+
+    void Scene2D::connectObservers() {
+        // destroying a parent releases its children where they are
+        m_reg.onDestroy<HBE::ECS::Children>([](HBE::ECS::Registry& reg, HBE::ECS::Entity e) {
+            const std::vector<HBE::ECS::Entity> children = reg.get<HBE::ECS::Children>(e).entities;
+            for (HBE::ECS::Entity c : children) detachKeepWorld(reg, c);
+            });
+
+        // keep the parent's Children list in sync when a Parent goes away (detach or destroy)
+        m_reg.onDestroy<HBE::ECS::Parent>([](HBE::ECS::Registry& reg, HBE::ECS::Entity e) {
+            const HBE::ECS::Entity p = reg.get<HBE::ECS::Parent>(e).entity;
+            if (!reg.valid(p) || !reg.has<HBE::ECS::Children>(p)) return;
+
+            auto& list = reg.get<HBE::ECS::Children>(p).entities;
+            list.erase(std::remove(list.begin(), list.end(), e), list.end());
+            });
+
+        // queries never report entities that lost their collider (added ones show up after the next update)
+        m_reg.onDestroy<HBE::ECS::Collider2D>([this](HBE::ECS::Registry&, HBE::ECS::Entity e) { removeQueryProxy(e); });
+        m_reg.onDestroy<Transform2D>([this](HBE::ECS::Registry&, HBE::ECS::Entity e) { removeQueryProxy(e); });
+
+        // explicit writes wake sleeping bodies (teleports, velocity/isStatic edits)
+        m_reg.onUpdate<HBE::ECS::RigidBody2D>([](HBE::ECS::Registry& reg, HBE::ECS::Entity e) {
+            wakeBody(reg.get<HBE::ECS::RigidBody2D>(e));
+            });
+        m_reg.onUpdate<Transform2D>([](HBE::ECS::Registry& reg, HBE::ECS::Entity e) {
+            if (!reg.has<HBE::ECS::RigidBody2D>(e)) return;
+            wakeBody(reg.get<HBE::ECS::RigidBody2D>(e));
+            });
+
+        // a recycled entity id must not blend from the previous owner's transform
+        m_reg.onConstruct<Transform2D>([this](HBE::ECS::Registry&, HBE::ECS::Entity e) {
+            if (e < m_prevStampOf.size()) m_prevStampOf[e] = 0;
+            m_staticTouched.push_back(e);
+            });
+
+        // candidates for a static grid rebuild (sorted out in resolveStaticCollisions)
+        const auto touchStatic = [this](HBE::ECS::Registry&, HBE::ECS::Entity e) { m_staticTouched.push_back(e); };
+        m_reg.onUpdate<Transform2D>(touchStatic);
+        m_reg.onDestroy<Transform2D>(touchStatic);
+        m_reg.onConstruct<HBE::ECS::Collider2D>(touchStatic);
+        m_reg.onUpdate<HBE::ECS::Collider2D>(touchStatic);
+        m_reg.onDestroy<HBE::ECS::Collider2D>(touchStatic);
+        m_reg.onConstruct<HBE::ECS::RigidBody2D>(touchStatic);
+        m_reg.onUpdate<HBE::ECS::RigidBody2D>(touchStatic);
+        m_reg.onDestroy<HBE::ECS::RigidBody2D>(touchStatic);
+        m_reg.onConstruct<HBE::ECS::Parent>(touchStatic);
+        m_reg.onDestroy<HBE::ECS::Parent>(touchStatic);
+    }
+
+    EntityID Scene2D::parentOf(EntityID id) const {
+        if (!m_reg.valid(id) || !m_reg.has<HBE::ECS::Parent>(id)) return InvalidEntityID;
+        return m_reg.get<HBE::ECS::Parent>(id).entity;
+    }
+
+    bool Scene2D::setParent(EntityID child, EntityID parent) {
+        if (!m_reg.valid(child)) return false;
+
+        if (parent != InvalidEntityID) {
+            if (!m_reg.valid(parent)) return false;
+
+            // walking up from the new parent must never reach the child
+            for (EntityID p = parent; p != InvalidEntityID; p = parentOf(p)) {
+                if (p == child) {
+                    LogError("Scene2D::setParent: parenting would create a cycle.");
+                    return false;
+                }
+            }
+        }
+
+        if (parentOf(child) == parent) return true;
+
+        if (parent == InvalidEntityID) {
+            detachKeepWorld(m_reg, child);
+            return true;
+        }
+
+        // keep the child where it is: local = parentWorld^-1 * world
+        const WorldTransform2D world = worldTransform(child);
+        const Transform2D local = TransformHierarchy2D::relativeTo(worldTransform(parent), world);
+
+        m_reg.remove<HBE::ECS::Parent>(child);
+        m_reg.emplace<HBE::ECS::Parent>(child, HBE::ECS::Parent{ parent });
+
+        if (!m_reg.has<HBE::ECS::Children>(parent)) m_reg.emplace<HBE::ECS::Children>(parent);
+        m_reg.get<HBE::ECS::Children>(parent).entities.push_back(child);
+
+        m_reg.emplace<Transform2D>(child, local);
+        m_reg.emplace<WorldTransform2D>(child, world);
+        return true;
+    }
+
     SpriteAnimationStateMachine* Scene2D::addSpriteAnimator(EntityID id, const SpriteRenderer2D::SpriteSheetHandle* sheet) {
         if (!m_reg.valid(id)) return nullptr;
 
@@ -78,8 +234,118 @@ namespace HBE::Renderer {
     }
 
     void Scene2D::setTileCollisionContext(const TileMap* map, const TileMapLayer* collisionLayer) {
+        m_collisionLayers.clear();
+        if (collisionLayer) m_collisionLayers.push_back(collisionLayer);
+
+        m_tileMap = map;
+        rebuildTileCollision();
+    }
+
+    void Scene2D::setTileCollisionLayers(const TileMap* map, const std::vector<const TileMapLayer*>& collisionLayers) {
+        m_collisionLayers.clear();
+        for (const TileMapLayer* layer : collisionLayers) {
+            if (layer) m_collisionLayers.push_back(layer);
+        }
+
         m_tileMap = map;
-        m_collisionLayer = collisionLayer;
+        rebuildTileCollision();
+    }
+
+    void Scene2D::rebuildTileCollision() {
+        m_tileGrid.clear();
+
+        if (m_tileMap) {
+            for (const TileMapLayer* layer : m_collisionLayers) m_tileGrid.merge(*m_tileMap, *layer);
+        }
+
+        m_tileRects.build(m_tileGrid);
+        syncTileRectColliders();
+
+        // whatever bodies rested on may be gone
+        wakeAllBodies();
+    }
+
+    void Scene2D::refreshTiles(int x0, int y0, int x1, int y1) {
+        if (!m_tileMap || m_tileGrid.empty()) return;
+
+        m_tileGrid.rebuildRegion(*m_tileMap, m_collisionLayers, x0, y0, x1, y1);
+        m_tileRects.update(m_tileGrid, x0, y0, x1, y1);
+        syncTileRectColliders();
+
+        wakeAllBodies();
+    }
+
+    void Scene2D::setTileRectColliders(bool enabled) {
+        if (enabled == m_tileRectColliders) return;
+        m_tileRectColliders = enabled;
+
+        if (!enabled) {
+            for (int id = 0; id < (int)m_tileRectEntities.size(); ++id) destroyTileRectCollider(id);
+            m_tileRectEntities.clear();
+            return;
+        }
+
+        // every alive rectangle has no entity yet
+        syncTileRectColliders();
+    }
+
+    GridPathfinder2D& Scene2D::pathfinder() {
+        m_pathfinder.sync(m_tileGrid);
+        return m_pathfinder;
+    }
+
+    void Scene2D::destroyTileRectCollider(int rect) {
+        if (rect < 0 || rect >= (int)m_tileRectEntities.size()) return;
+
+        // the entity may have been removed by hand (and its id recycled) meanwhile
+        const EntityID e = m_tileRectEntities[rect];
+        if (m_reg.valid(e) && m_reg.has<HBE::ECS::TileRectColliderComponent>(e) &&
+            m_reg.get<HBE::ECS::TileRectColliderComponent>(e).rect == rect) {
+            m_reg.destroy(e);
+        }
+        m_tileRectEntities[rect] = InvalidEntityID;
+    }
+
+    void Scene2D::syncTileRectColliders() {
+        if (!m_tileRectColliders) return;
+
+        for (int id : m_tileRects.removed()) destroyTileRectCollider(id);
+
+        const auto& rects = m_tileRects.rects();
+        m_tileRectEntities.resize(rects.size(), InvalidEntityID);
+
+        for (int id = 0; id < (int)rects.size(); ++id) {
+            if (!m_tileRects.alive(id) || m_tileRectEntities[id] != InvalidEntityID) continue;
+
+            const Bounds2D b = m_tileRects.worldBounds(id);
+
+            Transform2D tr;
+            tr.posX = (b.minX + b.maxX) * 0.5f;
+            tr.posY = (b.minY + b.maxY) * 0.5f;
+
+            HBE::ECS::Collider2D col;
+            col.halfW = (b.maxX - b.minX) * 0.5f;
+            col.halfH = (b.maxY - b.minY) * 0.5f;
+
+            HBE::ECS::RigidBody2D rb;
+            rb.isStatic = true;
+
+            const EntityID e = m_reg.create();
+            m_reg.emplace<Transform2D>(e, tr);
+            m_reg.emplace<HBE::ECS::Collider2D>(e, col);
+            m_reg.emplace<HBE::ECS::RigidBody2D>(e, rb);
+            m_reg.emplace<HBE::ECS::TileRectColliderComponent>(e, HBE::ECS::TileRectColliderComponent{ id });
+            m_tileRectEntities[id] = e;
+        }
+    }
+
+    void Scene2D::setPhysics2DSettings(const Physics2DSettings& s) {
+        m_physics = s;
+        wakeAllBodies();
+    }
+
+    void Scene2D::wakeAllBodies() {
+        m_reg.view<HBE::ECS::RigidBody2D>().each([](HBE::ECS::RigidBody2D& rb) { wakeBody(rb); });
     }
 
     void Scene2D::removeEntity(EntityID id) {
@@ -94,12 +360,28 @@ namespace HBE::Renderer {
     }
 
     void Scene2D::update(float dt, const SpriteAnimationStateMachine::EventCallback& onAnimEvent) {
-        // -----------------------------
-        // 1) Script system
-        // -----------------------------
-        for (auto e : m_reg.view<HBE::ECS::Script>()) {
-            auto& sc = m_reg.get<HBE::ECS::Script>(e);
+        // new change-detection frame: anything constructed/patched from here on is "this frame"
+        m_reg.advanceTick();
+
+        capturePreviousTransforms();
 
+        m_systems.run(m_reg, dt);
+
+        // animation events were buffered by the animation system; deliver them on this thread
+        if (onAnimEvent) {
+            for (const std::string& ev : m_animEvents) onAnimEvent(ev);
+        }
+        m_animEvents.clear();
+
+        // anything recorded by animation event callbacks
+        m_commands.flush(m_reg);
+    }
+
+    // -----------------------------
+    // 1) Script system
+    // -----------------------------
+    void Scene2D::updateScripts(float dt) {
+        for (auto [e, sc] : m_reg.view<HBE::ECS::Script>().each()) {
             // One-time create
             if (!m_reg.has<HBE::ECS::ScriptRuntimeState>(e)) {
                 auto& rt = m_reg.emplace<HBE::ECS::ScriptRuntimeState>(e);
@@ -115,20 +397,31 @@ namespace HBE::Renderer {
             if (sc.onUpdate) sc.onUpdate(e, dt);
         }
 
-        // -----------------------------
-        // 2) Physics + tile collision system (physics-lite)
-        // -----------------------------
-        const bool canTileCollide = (m_tileMap != nullptr && m_collisionLayer != nullptr);
+        // apply spawns/despawns requested by scripts before physics sees the world
+        m_commands.flush(m_reg);
+    }
+
+    // -----------------------------
+    // 2) Physics + tile collision system (physics-lite)
+    // -----------------------------
+    void Scene2D::updatePhysics(float dt) {
+        const bool canTileCollide = !m_tileGrid.empty();
 
         // Frame-level bookkeeping
-        for (auto e : m_reg.view<HBE::ECS::RigidBody2D>()) {
-            auto& rb = m_reg.get<HBE::ECS::RigidBody2D>(e);
-            rb.grounded = false;
+        m_reg.view<HBE::ECS::RigidBody2D>().each([&](HBE::ECS::RigidBody2D& rb) {
+            // velocity or acceleration written by game code wakes a sleeping body
+            // (sleeping zeroes velocity, so anything non-zero is new)
+            if (rb.sleeping && (rb.velX != 0.0f || rb.velY != 0.0f || rb.accelX != 0.0f || rb.accelY != 0.0f)) {
+                wakeBody(rb);
+            }
+
+            // sleepers keep the contacts they fell asleep with
+            if (!rb.sleeping) rb.grounded = false;
 
             if (rb.oneWayDisableTimer > 0.0f) {
                 rb.oneWayDisableTimer = std::max(0.0f, rb.oneWayDisableTimer - dt);
             }
-        }
+            });
 
         // Sub-stepping (stability)
         int steps = 1;
@@ -140,33 +433,68 @@ namespace HBE::Renderer {
             stepDt = (steps > 0) ? (dt / (float)steps) : dt;
         }
 
-        for (int step = 0; step < steps; ++step) {
-            for (auto e : m_reg.view<Transform2D, HBE::ECS::RigidBody2D>()) {
-                auto& tr = m_reg.get<Transform2D>(e);
-                auto& rb = m_reg.get<HBE::ECS::RigidBody2D>(e);
+        // Swept tile collision can't tunnel: tile bodies take one step per update and
+        // only fast ones walk more than one tile (sub-steps still apply to the SoA kernel).
+        const bool sweptTiles = canTileCollide && m_physics.sweptTileCollision;
+        const int tileSteps = sweptTiles ? 1 : steps;
+        const float tileDt = sweptTiles ? dt : stepDt;
+
+        // Bodies with Transform2D + RigidBody2D + Collider2D are packed at the front of
+        // the group-owned arrays, so the hot loops below are linear walks.
+        auto bodies = m_reg.group<Transform2D, HBE::ECS::RigidBody2D, HBE::ECS::Collider2D>();
+        auto* rbStorage = m_reg.tryStorage<HBE::ECS::RigidBody2D>();
+
+        auto integrateVelocity = [&](HBE::ECS::RigidBody2D& rb, float stepDt) {
+            // integrate acceleration -> velocity
+            rb.velX += rb.accelX * stepDt;
+            rb.velY += rb.accelY * stepDt;
+
+            // gravity
+            if (rb.useGravity) {
+                rb.velY += m_physics.gravityY * rb.gravityScale * stepDt;
+            }
 
-                if (rb.isStatic) continue;
+            if (rb.maxFallSpeed != 0.0f) {
+                rb.velY = std::max(rb.velY, rb.maxFallSpeed);
+            }
 
-                // integrate acceleration -> velocity
-                rb.velX += rb.accelX * stepDt;
-                rb.velY += rb.accelY * stepDt;
+            rb.velX = applyDamping(rb.velX, rb.linearDamping, stepDt);
+            rb.velY = applyDamping(rb.velY, rb.linearDamping, stepDt);
+            };
 
-                // gravity
-                if (rb.useGravity) {
-                    rb.velY += m_physics.gravityY * rb.gravityScale * stepDt;
-                }
+        // Bodies that never touch tiles are integrated in bulk: gather them once into the
+        // SoA working set, run every sub-step through the SIMD kernel, scatter once.
+        // (They don't interact with anything until the entity pass below.)
+        m_bodySoA.clear();
 
-                if (rb.maxFallSpeed != 0.0f) {
-                    rb.velY = std::max(rb.velY, rb.maxFallSpeed);
-                }
+        if (!canTileCollide) {
+            bodies.each([&](HBE::ECS::Entity e, Transform2D& tr, HBE::ECS::RigidBody2D& rb, HBE::ECS::Collider2D&) {
+                if (!rb.isStatic && !rb.sleeping && !m_reg.has<HBE::ECS::Parent>(e)) m_bodySoA.push(tr, rb);
+                });
+        }
+
+        // Rigidbodies without a collider live past the group's packed range.
+        const auto& rbDense = rbStorage->denseEntities();
+        for (std::size_t i = bodies.size(); i < rbDense.size(); ++i) {
+            const HBE::ECS::Entity e = rbDense[i];
+            if (!m_reg.has<Transform2D>(e)) continue;
+
+            auto& rb = rbStorage->dataAt(i);
+            if (rb.isStatic || rb.sleeping || m_reg.has<HBE::ECS::Parent>(e)) continue;
 
-                rb.velX = applyDamping(rb.velX, rb.linearDamping, stepDt);
-                rb.velY = applyDamping(rb.velY, rb.linearDamping, stepDt);
+            m_bodySoA.push(m_reg.get<Transform2D>(e), rb);
+        }
+
+        m_physicsStats.simdBodies = (int)m_bodySoA.size();
+        m_physicsStats.tileCollidingBodies = 0;
+        m_physicsStats.sweptBodies = 0;
 
-                const bool hasCollider = m_reg.has<HBE::ECS::Collider2D>(e);
+        for (int step = 0; step < steps; ++step) {
+            if (canTileCollide && step < tileSteps) {
+                bodies.each([&](HBE::ECS::Entity e, Transform2D& tr, HBE::ECS::RigidBody2D& rb, HBE::ECS::Collider2D& col) {
+                    if (rb.isStatic || rb.sleeping || m_reg.has<HBE::ECS::Parent>(e)) return;
 
-                if (canTileCollide && hasCollider) {
-                    auto& col = m_reg.get<HBE::ECS::Collider2D>(e);
+                    integrateVelocity(rb, tileDt);
 
                     // build center-based AABB in world space
                     HBE::Renderer::AABB box;
@@ -180,10 +508,18 @@ namespace HBE::Renderer {
                     const bool allowOneWay = rb.enableOneWay && (rb.oneWayDisableTimer <= 0.0f);
 
                     // Move with collision resolution (updates box + velocities)
-                    HBE::Renderer::MoveResult2D res =
-                        HBE::Renderer::TileCollision::moveAndCollideEx(
-                            *m_tileMap, *m_collisionLayer,
-                            box, rb.velX, rb.velY, stepDt,
+                    HBE::Renderer::MoveResult2D res = sweptTiles
+                        ? HBE::Renderer::TileCollision::moveAndCollideSwept(
+                            m_tileGrid,
+                            box, rb.velX, rb.velY, tileDt,
+                            rb.maxStepUp,
+                            allowOneWay,
+                            rb.enableSlopes,
+                            prevBottom
+                        )
+                        : HBE::Renderer::TileCollision::moveAndCollideEx(
+                            m_tileGrid,
+                            box, rb.velX, rb.velY, tileDt,
                             rb.maxStepUp,
                             allowOneWay,
                             rb.enableSlopes,
@@ -191,30 +527,136 @@ namespace HBE::Renderer {
                         );
 
                     if (res.grounded) rb.grounded = true;
+                    if (res.swept) ++m_physicsStats.sweptBodies;
 
                     // write back resolved position (undo collider offset)
                     tr.posX = box.cx - col.offsetX;
                     tr.posY = box.cy - col.offsetY;
+
+                    if (step == 0) ++m_physicsStats.tileCollidingBodies;
+                    });
+            }
+
+            RigidBodyIntegrator2D::integrate(m_bodySoA, m_physics.gravityY, stepDt);
+        }
+
+        m_bodySoA.scatter();
+    }
+
+    // -----------------------------
+    // 2.4) Dynamic-vs-dynamic collision (AABB vs AABB)
+    // Sweep-and-prune broadphase, then each overlapping pair is pushed apart along
+    // the axis of minimum penetration, split by inverse mass, and loses its
+    // approaching relative velocity along that axis (inelastic).
+    // -----------------------------
+    void Scene2D::resolveDynamicCollisions() {
+        m_dynamicBodies.clear();
+        m_dynamicPairs.clear();
+
+        if (!m_physics.dynamicCollisions) {
+            m_physicsStats.dynamicBodies = 0;
+            m_physicsStats.dynamicPairs = 0;
+            return;
+        }
+
+        auto bodies = m_reg.group<Transform2D, HBE::ECS::RigidBody2D, HBE::ECS::Collider2D>();
+
+        m_broadphase.begin();
+        bodies.each([&](HBE::ECS::Entity e, Transform2D& tr, HBE::ECS::RigidBody2D& rb, HBE::ECS::Collider2D& col) {
+            if (rb.isStatic || col.isTrigger || m_reg.has<HBE::ECS::Parent>(e)) return;
+
+            const float cx = tr.posX + col.offsetX;
+            const float cy = tr.posY + col.offsetY;
+            m_broadphase.add(e, cx - col.halfW, cy - col.halfH, cx + col.halfW, cy + col.halfH);
+
+            const float invMass = (rb.mass > 0.0f) ? 1.0f / rb.mass : 0.0f;
+            m_dynamicBodies.push_back(DynamicBody{ &tr, &rb, &col, invMass });
+            });
+
+        m_broadphase.findPairs(m_dynamicPairs);
+
+        m_physicsStats.dynamicBodies = (int)m_dynamicBodies.size();
+        m_physicsStats.dynamicPairs = (int)m_dynamicPairs.size();
+
+        for (const SweepAndPrune2D::Pair& pair : m_dynamicPairs) {
+            DynamicBody& a = m_dynamicBodies[pair.a];
+            DynamicBody& b = m_dynamicBodies[pair.b];
+
+            // sleeping bodies stay in the broadphase so awake ones can run into them
+            if (a.rb->sleeping && b.rb->sleeping) continue;
+
+            const float invSum = a.invMass + b.invMass;
+            if (invSum <= 0.0f) continue; // both immovable
+
+            // positions may have moved through earlier pairs: test the live boxes
+            const float dx = (b.tr->posX + b.col->offsetX) - (a.tr->posX + a.col->offsetX);
+            const float px = (a.col->halfW + b.col->halfW) - std::fabs(dx);
+            if (px <= 0.0f) continue;
+
+            const float dy = (b.tr->posY + b.col->offsetY) - (a.tr->posY + a.col->offsetY);
+            const float py = (a.col->halfH + b.col->halfH) - std::fabs(dy);
+            if (py <= 0.0f) continue;
+
+            // real contact (not just touching) wakes a sleeper
+            if (a.rb->sleeping) wakeBody(*a.rb);
+            if (b.rb->sleeping) wakeBody(*b.rb);
+
+            const float shareA = a.invMass / invSum;
+            const float shareB = b.invMass / invSum;
+
+            if (px < py) {
+                const float n = (dx < 0.0f) ? 1.0f : -1.0f; // direction a gets pushed
+                a.tr->posX += n * px * shareA;
+                b.tr->posX -= n * px * shareB;
+
+                const float vn = (a.rb->velX - b.rb->velX) * n;
+                if (vn < 0.0f) {
+                    const float j = -vn / invSum;
+                    a.rb->velX += n * j * a.invMass;
+                    b.rb->velX -= n * j * b.invMass;
                 }
-                else {
-                    // simple Euler integrate
-                    tr.posX += rb.velX * stepDt;
-                    tr.posY += rb.velY * stepDt;
+            }
+            else {
+                const float n = (dy < 0.0f) ? 1.0f : -1.0f;
+                a.tr->posY += n * py * shareA;
+                b.tr->posY -= n * py * shareB;
+
+                const float vn = (a.rb->velY - b.rb->velY) * n;
+                if (vn < 0.0f) {
+                    const float j = -vn / invSum;
+                    a.rb->velY += n * j * a.invMass;
+                    b.rb->velY -= n * j * b.invMass;
                 }
             }
         }
+    }
+
+    // -----------------------------
+    // 2.5) Entity-vs-Entity collision (AABB vs AABB)
+    // Dynamic colliders push out of static colliders.
+    // Attached (parented) colliders count as static when the root of their hierarchy
+    // is static or has no body, and move with it; their world transform is the one
+    // from the previous frame's hierarchy pass. Colliders attached under a dynamic
+    // body (a weapon on the player) are left out: they'd push their own root.
+    // -----------------------------
+    bool Scene2D::isStaticCollider(EntityID e) const {
+        if (!m_reg.valid(e) || !m_reg.has<Transform2D>(e) || !m_reg.has<HBE::ECS::Collider2D>(e)) return false;
+
+        EntityID root = e;
+        for (EntityID p = parentOf(e); p != InvalidEntityID; p = parentOf(p)) root = p;
+        return !m_reg.has<HBE::ECS::RigidBody2D>(root) || m_reg.get<HBE::ECS::RigidBody2D>(root).isStatic;
+    }
+
+    void Scene2D::resolveStaticCollisions() {
+        auto bodies = m_reg.group<Transform2D, HBE::ECS::RigidBody2D, HBE::ECS::Collider2D>();
 
-        // -----------------------------
-        // 2.5) Entity-vs-Entity collision (AABB vs AABB)
-        // Dynamic colliders push out of static colliders.
-        // -----------------------------
         struct WorldAABB {
             float cx, cy; // center
             float hx, hy; // half extents
         };
 
         auto makeAABB = [&](HBE::ECS::Entity e) -> WorldAABB {
-            const auto& tr = m_reg.get<Transform2D>(e);
+            const WorldTransform2D tr = TransformHierarchy2D::worldOf(m_reg, e);
             const auto& col = m_reg.get<HBE::ECS::Collider2D>(e);
 
             WorldAABB a;
@@ -246,64 +688,249 @@ namespace HBE::Renderer {
             return true;
             };
 
-        // Build a list of static colliders
-        std::vector<HBE::ECS::Entity> statics;
-        statics.reserve(128);
+        // Static collider grid: only rebuilt when a static was added, removed or moved.
+        // Dynamic spawns and body patches also land in m_staticTouched but are neither
+        // static now nor were they at the last build, so they cost one check each.
+        // Attached colliders move every frame without a patch: they stay out of the grid
+        // and are tested one by one (expected to be few).
+        bool staticsDirty = !m_staticsValid
+            || m_staticsCellSetting != m_physics.staticGridCellSize
+            || m_staticsSnapshotLoads != m_reg.snapshotLoads();
+
+        for (HBE::ECS::Entity e : m_staticTouched) {
+            if (staticsDirty) break;
+            // changes to a parent (its body, its own parent) can turn attached colliders
+            // into statics or back
+            staticsDirty = (e < m_staticMember.size() && m_staticMember[e]) || isStaticCollider(e)
+                || (m_reg.valid(e) && m_reg.has<HBE::ECS::Children>(e));
+        }
+        m_staticTouched.clear();
 
-        for (auto e : m_reg.view<Transform2D, HBE::ECS::Collider2D>()) {
-            bool isStatic = true;
+        if (staticsDirty) {
+            const bool rebuilt = m_staticsValid;
 
-            if (m_reg.has<HBE::ECS::RigidBody2D>(e)) {
-                isStatic = m_reg.get<HBE::ECS::RigidBody2D>(e).isStatic;
-            }
+            m_staticGrid.clear();
+            m_staticGrid.setCellSize(m_physics.staticGridCellSize);
+            m_attachedStatics.clear();
+            std::fill(m_staticMember.begin(), m_staticMember.end(), char(0));
 
-            if (isStatic) {
-                statics.push_back(e);
-            }
+            const auto markMember = [&](HBE::ECS::Entity e) {
+                if (e >= m_staticMember.size()) m_staticMember.resize(e + 1, 0);
+                m_staticMember[e] = 1;
+                };
+
+            m_reg.view<Transform2D, HBE::ECS::Collider2D>().each([&](HBE::ECS::Entity e, Transform2D&, HBE::ECS::Collider2D&) {
+                if (!isStaticCollider(e)) return;
+
+                if (m_reg.has<HBE::ECS::Parent>(e)) {
+                    m_attachedStatics.push_back(e);
+                    markMember(e);
+                    return;
+                }
+
+                const WorldAABB b = makeAABB(e);
+                m_staticGrid.add(e, b.cx, b.cy, b.hx, b.hy);
+                markMember(e);
+                });
+
+            m_staticGrid.build();
+
+            // static geometry changed under bodies that may be resting on it
+            if (rebuilt) wakeAllBodies();
+
+            m_staticsSnapshotLoads = m_reg.snapshotLoads();
+            m_staticsCellSetting = m_physics.staticGridCellSize;
+            m_staticsValid = true;
         }
 
+        m_physicsStats.staticColliders = (int)(m_staticGrid.boxCount() + m_attachedStatics.size());
+        m_physicsStats.staticPairTests = 0;
+
         // Dynamic bodies collide against statics
-        for (auto e : m_reg.view<Transform2D, HBE::ECS::RigidBody2D, HBE::ECS::Collider2D>()) {
-            auto& tr = m_reg.get<Transform2D>(e);
-            auto& rb = m_reg.get<HBE::ECS::RigidBody2D>(e);
+        bodies.each([&](HBE::ECS::Entity e, Transform2D& tr, HBE::ECS::RigidBody2D& rb, HBE::ECS::Collider2D& col) {
+            if (rb.isStatic || m_reg.has<HBE::ECS::Parent>(e)) return;
+
+            WorldAABB a;
+            a.cx = tr.posX + col.offsetX;
+            a.cy = tr.posY + col.offsetY;
+            a.hx = col.halfW;
+            a.hy = col.halfH;
+
+            // sleepers only need to notice attached colliders moving into them
+            // (the grid doesn't change without waking everyone)
+            if (rb.sleeping) {
+                float pushX = 0.0f, pushY = 0.0f;
+                for (HBE::ECS::Entity s : m_attachedStatics) {
+                    if (s != e && overlap(a, makeAABB(s), pushX, pushY)) {
+                        wakeBody(rb);
+                        break;
+                    }
+                }
+                if (rb.sleeping) return;
+            }
+
+            auto resolveAgainst = [&](const WorldAABB& b) -> bool {
+                ++m_physicsStats.staticPairTests;
 
-            if (rb.isStatic) continue;
+                float pushX = 0.0f, pushY = 0.0f;
+                if (!overlap(a, b, pushX, pushY)) return false;
+
+                tr.posX += pushX;
+                tr.posY += pushY;
+                a.cx += pushX;
+                a.cy += pushY;
+
+                if (pushX != 0.0f) rb.velX = 0.0f;
+                if (pushY != 0.0f) rb.velY = 0.0f;
+                return true;
+                };
 
             // Iteratively resolve (a couple passes helps prevent tunneling when overlapping)
             for (int pass = 0; pass < 2; ++pass) {
                 bool anyResolved = false;
 
-                for (auto s : statics) {
+                // cells are picked from the box at the start of the pass; pushes are small
+                // and the second pass re-queries from the resolved position
+                m_staticGrid.query(a.cx - a.hx, a.cy - a.hy, a.cx + a.hx, a.cy + a.hy,
+                    [&](const StaticColliderGrid2D::Box& s) {
+                        if (s.entity == e) return;
+                        if (resolveAgainst(WorldAABB{ s.cx, s.cy, s.hx, s.hy })) anyResolved = true;
+                    });
+
+                for (HBE::ECS::Entity s : m_attachedStatics) {
                     if (s == e) continue;
+                    if (resolveAgainst(makeAABB(s))) anyResolved = true;
+                }
+
+                if (!anyResolved) break;
+            }
+            });
+    }
 
-                    float pushX = 0.0f, pushY = 0.0f;
+    // -----------------------------
+    // 2.6) Sleeping
+    // A body that stays below sleepVelocity for sleepFrames updates stops being
+    // integrated and collided. Dynamic bodies whose boxes touch form islands (rebuilt
+    // every frame from the broadphase pairs): an island falls asleep once all of its
+    // members are ready and wakes as a whole when any member moves, so a stack never
+    // sleeps half-way and a body bumping into a resting pile wakes the pile.
+    // -----------------------------
+    void Scene2D::updateSleep() {
+        m_physicsStats.awakeBodies = 0;
+        m_physicsStats.sleepingBodies = 0;
+
+        const float sleepVel2 = m_physics.sleepVelocity * m_physics.sleepVelocity;
+        const int sleepFrames = std::max(1, m_physics.sleepFrames);
+
+        // stillness per body; bodies outside the dynamic set decide on their own
+        m_reg.view<HBE::ECS::RigidBody2D>().each([&](HBE::ECS::Entity e, HBE::ECS::RigidBody2D& rb) {
+            if (rb.isStatic || m_reg.has<HBE::ECS::Parent>(e)) return;
+
+            if (!m_physics.sleeping || !rb.canSleep) {
+                wakeBody(rb);
+                ++m_physicsStats.awakeBodies;
+                return;
+            }
 
-                    WorldAABB a = makeAABB(e);
-                    WorldAABB b = makeAABB(s);
+            if (!rb.sleeping) {
+                const bool still = rb.accelX == 0.0f && rb.accelY == 0.0f &&
+                    (rb.velX * rb.velX + rb.velY * rb.velY) < sleepVel2;
+                rb.stillFrames = still ? std::min(rb.stillFrames + 1, sleepFrames) : 0;
+            }
 
-                    if (!overlap(a, b, pushX, pushY)) continue;
+            const bool inIsland = m_physics.dynamicCollisions && m_reg.has<Transform2D>(e) && m_reg.has<HBE::ECS::Collider2D>(e) &&
+                !m_reg.get<HBE::ECS::Collider2D>(e).isTrigger;
+            if (inIsland) return;
 
-                    tr.posX += pushX;
-                    tr.posY += pushY;
+            if (!rb.sleeping && rb.stillFrames >= sleepFrames) {
+                rb.sleeping = true;
+                rb.velX = 0.0f;
+                rb.velY = 0.0f;
+            }
 
-                    if (pushX != 0.0f) rb.velX = 0.0f;
-                    if (pushY != 0.0f) rb.velY = 0.0f;
+            if (rb.sleeping) ++m_physicsStats.sleepingBodies;
+            else ++m_physicsStats.awakeBodies;
+            });
 
-                    anyResolved = true;
-                }
+        // islands over the dynamic set (filled by resolveDynamicCollisions this frame)
+        const std::size_t n = m_dynamicBodies.size();
+        if (!m_physics.sleeping || n == 0) return;
 
-                if (!anyResolved) break;
+        m_islandRoot.resize(n);
+        for (std::size_t i = 0; i < n; ++i) m_islandRoot[i] = static_cast<std::uint32_t>(i);
+
+        auto findRoot = [&](std::uint32_t i) {
+            while (m_islandRoot[i] != i) {
+                m_islandRoot[i] = m_islandRoot[m_islandRoot[i]]; // path halving
+                i = m_islandRoot[i];
             }
+            return i;
+            };
+
+        auto moving = [](const HBE::ECS::RigidBody2D& rb) { return !rb.sleeping && rb.stillFrames == 0; };
+
+        // bodies that never sleep (player...) don't join islands, they only wake what they push
+        for (const SweepAndPrune2D::Pair& pair : m_dynamicPairs) {
+            if (!m_dynamicBodies[pair.a].rb->canSleep || !m_dynamicBodies[pair.b].rb->canSleep) continue;
+
+            const std::uint32_t rootA = findRoot(pair.a);
+            const std::uint32_t rootB = findRoot(pair.b);
+            if (rootA != rootB) m_islandRoot[rootA] = rootB;
+        }
+
+        m_islandStill.assign(n, sleepFrames);
+        m_islandWake.assign(n, 0);
+
+        for (std::size_t i = 0; i < n; ++i) {
+            const HBE::ECS::RigidBody2D& rb = *m_dynamicBodies[i].rb;
+            if (!rb.canSleep || rb.sleeping) continue;
+
+            const std::uint32_t r = findRoot(static_cast<std::uint32_t>(i));
+            m_islandStill[r] = std::min(m_islandStill[r], rb.stillFrames);
+            if (moving(rb)) m_islandWake[r] = 1;
         }
 
-        // -----------------------------
-        // 3) Animation system (UV updates)
-        // -----------------------------
-        for (auto e : m_reg.view<AnimationComponent2D, SpriteComponent2D>()) {
-            auto& anim = m_reg.get<AnimationComponent2D>(e).sm;
-            auto& spr = m_reg.get<SpriteComponent2D>(e);
+        for (const SweepAndPrune2D::Pair& pair : m_dynamicPairs) {
+            const HBE::ECS::RigidBody2D& a = *m_dynamicBodies[pair.a].rb;
+            const HBE::ECS::RigidBody2D& b = *m_dynamicBodies[pair.b].rb;
+
+            if (b.sleeping && moving(a)) m_islandWake[findRoot(pair.b)] = 1;
+            if (a.sleeping && moving(b)) m_islandWake[findRoot(pair.a)] = 1;
+        }
 
-            anim.update(dt, onAnimEvent);
+        for (std::size_t i = 0; i < n; ++i) {
+            HBE::ECS::RigidBody2D& rb = *m_dynamicBodies[i].rb;
+            if (!rb.canSleep) continue;
+
+            const std::uint32_t r = findRoot(static_cast<std::uint32_t>(i));
+
+            if (m_islandWake[r]) {
+                if (rb.sleeping) wakeBody(rb);
+            }
+            else if (!rb.sleeping && m_islandStill[r] >= sleepFrames) {
+                rb.sleeping = true;
+                rb.velX = 0.0f;
+                rb.velY = 0.0f;
+            }
+
+            if (rb.sleeping) ++m_physicsStats.sleepingBodies;
+            else ++m_physicsStats.awakeBodies;
+        }
+    }
+
+    // -----------------------------
+    // 3) Animation system (UV updates)
+    // -----------------------------
+    void Scene2D::updateAnimation(float dt) {
+        // may run next to physics: buffer events instead of calling game code from here
+        const SpriteAnimationStateMachine::EventCallback collect = [this](const std::string& ev) {
+            m_animEvents.push_back(ev);
+            };
+
+        m_reg.view<AnimationComponent2D, SpriteComponent2D>().each([&](AnimationComponent2D& ac, SpriteComponent2D& spr) {
+            auto& anim = ac.sm;
+
+            anim.update(dt, collect);
 
             // Apply animation to UVs.
             RenderItem tmp;
@@ -316,7 +943,54 @@ namespace HBE::Renderer {
             anim.apply(tmp);
 
             std::memcpy(spr.uvRect, tmp.uvRect, sizeof(tmp.uvRect));
+            });
+    }
+
+    static Transform2D toTransform(const WorldTransform2D& w) {
+        Transform2D t;
+        t.posX = w.posX;
+        t.posY = w.posY;
+        t.rotation = w.rotation;
+        t.scaleX = w.scaleX;
+        t.scaleY = w.scaleY;
+        return t;
+    }
+
+    void Scene2D::capturePreviousTransforms() {
+        ++m_prevStamp;
+        if (m_prevStamp == 0) { // wrapped: 0 means "never captured"
+            std::fill(m_prevStampOf.begin(), m_prevStampOf.end(), 0u);
+            m_prevStamp = 1;
         }
+
+        m_reg.view<Transform2D>().each([&](HBE::ECS::Entity e, Transform2D& tr) {
+            if (e >= m_prevTransforms.size()) {
+                m_prevTransforms.resize(static_cast<std::size_t>(e) + 1);
+                m_prevStampOf.resize(static_cast<std::size_t>(e) + 1, 0u);
+            }
+
+            m_prevTransforms[e] = m_reg.has<WorldTransform2D>(e) ? toTransform(m_reg.get<WorldTransform2D>(e)) : tr;
+            m_prevStampOf[e] = m_prevStamp;
+            });
+    }
+
+    Transform2D Scene2D::renderTransform(EntityID id) const {
+        const Transform2D cur = toTransform(TransformHierarchy2D::worldOf(m_reg, id));
+
+        // spawned during the last update (nothing to blend from) or interpolation off
+        if (m_renderAlpha >= 1.0f || id >= m_prevStampOf.size() || m_prevStampOf[id] != m_prevStamp) return cur;
+
+        const Transform2D& prev = m_prevTransforms[id];
+        const float a = std::max(0.0f, m_renderAlpha);
+        constexpr float TwoPi = 6.28318530718f;
+
+        Transform2D t;
+        t.posX = prev.posX + (cur.posX - prev.posX) * a;
+        t.posY = prev.posY + (cur.posY - prev.posY) * a;
+        t.rotation = prev.rotation + std::remainder(cur.rotation - prev.rotation, TwoPi) * a; // shortest way round
+        t.scaleX = prev.scaleX + (cur.scaleX - prev.scaleX) * a;
+        t.scaleY = prev.scaleY + (cur.scaleY - prev.scaleY) * a;
+        return t;
     }
 
     void Scene2D::render(Renderer2D& renderer) {
@@ -339,9 +1013,21 @@ namespace HBE::Renderer {
             canCull = m_cullingEnabled;
         }
 
-        for (auto e : m_reg.view<Transform2D, SpriteComponent2D>()) {
-            auto& tr = m_reg.get<Transform2D>(e);
-            auto& spr = m_reg.get<SpriteComponent2D>(e);
+        // Keep the sprite storage in draw order (same key as SpriteBatch2D) so quads
+        // are submitted already sorted and the batch can skip its own sort.
+        // Order is nearly unchanged frame to frame, so this is usually a linear pass.
+        // Transform2D can't follow via sortAs: its order belongs to the physics group.
+        m_reg.sort<SpriteComponent2D>([](const SpriteComponent2D& a, const SpriteComponent2D& b) {
+            if (a.layer != b.layer) return a.layer < b.layer;
+            if (a.material != b.material) return a.material < b.material;
+            return a.sortKey < b.sortKey;
+            });
+
+        m_reg.view<SpriteComponent2D>().each([&](HBE::ECS::Entity e, SpriteComponent2D& spr) {
+            if (!m_reg.has<Transform2D>(e)) return;
+
+            // world transform (parented sprites), blended for render interpolation
+            const Transform2D tr = renderTransform(e);
 
             // simple world-space AABB for sprite culling
             if (canCull) {
@@ -353,7 +1039,7 @@ namespace HBE::Renderer {
                 const float maxY = tr.posY + 0.5f * std::fabs(tr.scaleY) + pad;
 
                 if (maxX < viewL || minX > viewR || maxY < viewB || minY > viewT)
-                    continue;
+                    return;
             }
 
             RenderItem item;
@@ -365,14 +1051,157 @@ namespace HBE::Renderer {
             std::memcpy(item.uvRect, spr.uvRect, sizeof(item.uvRect));
 
             renderer.draw(item);
+            });
+    }
+
+    // -----------------------------
+    // Scene queries
+    // -----------------------------
+    static Bounds2D colliderBounds(const HBE::ECS::Registry& reg, HBE::ECS::Entity e, const Transform2D& tr, const HBE::ECS::Collider2D& col) {
+        float x = tr.posX, y = tr.posY;
+        if (reg.has<WorldTransform2D>(e)) {
+            const WorldTransform2D& w = reg.get<WorldTransform2D>(e);
+            x = w.posX;
+            y = w.posY;
         }
+
+        const float cx = x + col.offsetX;
+        const float cy = y + col.offsetY;
+        return Bounds2D{ cx - col.halfW, cy - col.halfH, cx + col.halfW, cy + col.halfH };
+    }
+
+    void Scene2D::removeQueryProxy(EntityID e) {
+        if (e >= m_queryProxy.size() || m_queryProxy[e] == DynamicAABBTree2D::Null) return;
+
+        m_queryTree.destroyProxy(m_queryProxy[e]);
+        m_queryProxy[e] = DynamicAABBTree2D::Null;
+    }
+
+    void Scene2D::syncQueryTree() {
+        // Physics writes positions without patching, so every collider is compared
+        // against its fat box; only the ones that left it are re-inserted.
+        ++m_queryStamp;
+        std::size_t visited = 0;
+
+        m_reg.view<Transform2D, HBE::ECS::Collider2D>().each([&](HBE::ECS::Entity e, Transform2D& tr, HBE::ECS::Collider2D& col) {
+            if (e >= m_queryProxy.size()) {
+                m_queryProxy.resize(static_cast<std::size_t>(e) + 1, DynamicAABBTree2D::Null);
+                m_querySeen.resize(static_cast<std::size_t>(e) + 1, 0u);
+            }
+
+            const Bounds2D b = colliderBounds(m_reg, e, tr, col);
+
+            int& proxy = m_queryProxy[e];
+            if (proxy == DynamicAABBTree2D::Null) proxy = m_queryTree.createProxy(b, e);
+            else m_queryTree.moveProxy(proxy, b);
+
+            m_querySeen[e] = m_queryStamp;
+            ++visited;
+            });
+
+        // proxies of colliders that vanished without a destroy signal (snapshot restore)
+        if (m_queryTree.proxyCount() != visited) {
+            for (std::size_t e = 0; e < m_queryProxy.size(); ++e) {
+                if (m_queryProxy[e] != DynamicAABBTree2D::Null && m_querySeen[e] != m_queryStamp) {
+                    removeQueryProxy(static_cast<EntityID>(e));
+                }
+            }
+        }
+    }
+
+    bool Scene2D::raycast(float x0, float y0, float x1, float y1, RaycastHit2D& outHit, EntityID ignore) const {
+        outHit = RaycastHit2D{};
+
+        m_queryTree.raycast(x0, y0, x1, y1, [&](std::uint32_t e, const Bounds2D& box, float fraction, float maxFraction) -> float {
+            if (e == ignore) return maxFraction;
+
+            float t = fraction, nx = 0.0f, ny = 0.0f;
+            SegmentVsBounds(box, x0, y0, x1 - x0, y1 - y0, maxFraction, t, nx, ny);
+
+            outHit.entity = e;
+            outHit.fraction = t;
+            outHit.pointX = x0 + (x1 - x0) * t;
+            outHit.pointY = y0 + (y1 - y0) * t;
+            outHit.normalX = nx;
+            outHit.normalY = ny;
+            return t; // keep looking for something closer
+            });
+
+        return outHit.entity != InvalidEntityID;
+    }
+
+    std::size_t Scene2D::overlapBox(float minX, float minY, float maxX, float maxY, EntityID* out, std::size_t capacity) const {
+        std::size_t n = 0;
+        if (capacity == 0) return 0;
+
+        m_queryTree.query(Bounds2D{ minX, minY, maxX, maxY }, [&](std::uint32_t e, const Bounds2D&) {
+            out[n++] = e;
+            return n < capacity;
+            });
+
+        return n;
+    }
+
+    std::size_t Scene2D::queryPoint(float x, float y, EntityID* out, std::size_t capacity) const {
+        return overlapBox(x, y, x, y, out, capacity);
+    }
+
+    void Scene2D::raycastBatch(const Ray2D* rays, std::size_t count, RaycastHit2D* outHits) const {
+        auto run = [&](std::size_t begin, std::size_t end) {
+            for (std::size_t i = begin; i < end; ++i) {
+                const Ray2D& r = rays[i];
+                raycast(r.x0, r.y0, r.x1, r.y1, outHits[i], r.ignore);
+            }
+            };
+
+        HBE::Core::JobSystem* jobs = HBE::Core::JobSystem::Get();
+        if (!jobs) {
+            run(0, count);
+            return;
+        }
+
+        jobs->parallelFor(count, 64, run);
+    }
+
+    void Scene2D::overlapBoxBatch(const QueryBox2D* boxes, std::size_t count, EntityID* out, std::size_t capacityPerBox, std::size_t* outCounts) const {
+        auto run = [&](std::size_t begin, std::size_t end) {
+            for (std::size_t i = begin; i < end; ++i) {
+                const QueryBox2D& b = boxes[i];
+                outCounts[i] = overlapBox(b.minX, b.minY, b.maxX, b.maxY, out + i * capacityPerBox, capacityPerBox);
+            }
+            };
+
+        HBE::Core::JobSystem* jobs = HBE::Core::JobSystem::Get();
+        if (!jobs) {
+            run(0, count);
+            return;
+        }
+
+        jobs->parallelFor(count, 64, run);
     }
 
     void Scene2D::clear() {
         // simplest: reset registry and runtime-only pointers
         m_reg = HBE::ECS::Registry{};
+        m_commands.clear();
+        m_staticGrid.clear();
+        m_attachedStatics.clear();
+        m_staticTouched.clear();
+        m_staticMember.clear();
+        m_staticsValid = false;
+        m_broadphase.clear();
+        m_hierarchy.reset();
+        m_queryTree.clear();
+        m_queryProxy.clear();
+        m_querySeen.clear();
+        m_prevTransforms.clear();
+        m_prevStampOf.clear();
+        connectObservers(); // the new registry has no observers
         m_tileMap = nullptr;
-        m_collisionLayer = nullptr;
+        m_collisionLayers.clear();
+        m_tileGrid.clear();
+        m_tileRects.clear();
+        m_tileRectEntities.clear(); // went with the registry
     }
 
 } // namespace HBE::Renderer
\ No newline at end of file
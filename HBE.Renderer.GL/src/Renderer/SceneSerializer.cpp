@@ -9,10 +9,14 @@
 #include "HBE/Renderer/Mesh.h"
 #include "HBE/Renderer/Material.h"
 #include "HBE/Renderer/Transform2D.h"
+#include "HBE/Renderer/TransformHierarchy2D.h"
 #include "HBE/ECS/ESCSComponents2D.h"
 
 #include <fstream>
 #include <sstream>
+#include <unordered_map>
+#include <utility>
+#include <vector>
 #include <json.hpp>
 
 using json = nlohmann::json;
@@ -53,6 +57,21 @@ namespace HBE::Renderer {
         t.rotation = j.value("rot", 0.0f);
     }
 
+    // World pose from the local transforms up the parent chain (WorldTransform2D
+    // is only refreshed by Scene2D::update, so it may be stale here).
+    static Transform2D worldFromLocals(const HBE::ECS::Registry& reg, HBE::ECS::Entity e) {
+        const Transform2D& local = reg.get<Transform2D>(e);
+        if (!reg.has<HBE::ECS::Parent>(e)) return local;
+
+        const HBE::ECS::Entity p = reg.get<HBE::ECS::Parent>(e).entity;
+        if (!reg.valid(p) || !reg.has<Transform2D>(p)) return local;
+
+        const Transform2D pt = worldFromLocals(reg, p);
+        const WorldTransform2D parent{ pt.posX, pt.posY, pt.rotation, pt.scaleX, pt.scaleY };
+        const WorldTransform2D w = TransformHierarchy2D::compose(parent, local);
+        return Transform2D{ w.posX, w.posY, w.rotation, w.scaleX, w.scaleY };
+    }
+
     static json toJsonSprite(const SpriteComponent2D& s,
         const SceneSaveCallbacks& cb)
     {
@@ -136,6 +155,8 @@ namespace HBE::Renderer {
             {"accelX", r.accelX}, {"accelY", r.accelY},
             {"linearDamping", r.linearDamping},
             {"isStatic", r.isStatic},
+            {"mass", r.mass},
+            {"canSleep", r.canSleep},
             {"useGravity", r.useGravity},
             {"gravityScale", r.gravityScale},
             {"grounded", r.grounded},
@@ -154,6 +175,8 @@ namespace HBE::Renderer {
         r.accelY = j.value("accelY", 0.0f);
         r.linearDamping = j.value("linearDamping", 0.0f);
         r.isStatic = j.value("isStatic", false);
+        r.mass = j.value("mass", 1.0f);
+        r.canSleep = j.value("canSleep", true);
 
         r.useGravity = j.value("useGravity", false);
         r.gravityScale = j.value("gravityScale", 1.0f);
@@ -187,15 +210,20 @@ namespace HBE::Renderer {
 
         json ents = json::array();
 
-        // Driver: entities that have Transform2D
+        // Ensure stable IDs exist first: children refer to their parent by uuid
         for (auto e : reg.view<Transform2D>()) {
-
-            // Ensure stable ID exists
+            if (reg.has<HBE::ECS::TileRectColliderComponent>(e)) continue;
             if (!reg.has<HBE::ECS::IDComponent>(e)) {
                 HBE::ECS::IDComponent id{};
                 id.uuid = HBE::Core::NewUUID32();
                 reg.emplace<HBE::ECS::IDComponent>(e, id);
             }
+        }
+
+        // Driver: entities that have Transform2D
+        for (auto e : reg.view<Transform2D>()) {
+            // scene-owned, regenerated from the tile map
+            if (reg.has<HBE::ECS::TileRectColliderComponent>(e)) continue;
 
             const auto& id = reg.get<HBE::ECS::IDComponent>(e);
 
@@ -210,10 +238,18 @@ namespace HBE::Renderer {
                 ej["name"] = std::string("Entity_") + id.uuid.substr(0, 6);
             }
 
+            // Parent (by uuid; re-linked with Scene2D::setParent on load)
+            if (reg.has<HBE::ECS::Parent>(e)) {
+                const HBE::ECS::Entity p = reg.get<HBE::ECS::Parent>(e).entity;
+                if (reg.valid(p) && reg.has<HBE::ECS::IDComponent>(p)) {
+                    ej["parent"] = reg.get<HBE::ECS::IDComponent>(p).uuid;
+                }
+            }
+
             json comps;
 
-            // Transform
-            comps["Transform2D"] = toJsonTransform(reg.get<Transform2D>(e));
+            // Transform (always the world pose, so files stay valid without the hierarchy)
+            comps["Transform2D"] = toJsonTransform(worldFromLocals(reg, e));
 
             // Sprite
             if (reg.has<SpriteComponent2D>(e)) {
@@ -306,6 +342,10 @@ namespace HBE::Renderer {
         scene.clear();
         auto& reg = scene.registry();
 
+        // children to re-link once every entity exists
+        std::unordered_map<std::string, HBE::ECS::Entity> byUUID;
+        std::vector<std::pair<HBE::ECS::Entity, std::string>> parentLinks;
+
         // Create entities
         for (auto& ej : root["entities"]) {
             const std::string uuid = ej.value("uuid", "");
@@ -320,12 +360,16 @@ namespace HBE::Renderer {
                 HBE::ECS::IDComponent id{};
                 id.uuid = uuid.empty() ? HBE::Core::NewUUID32() : uuid;
                 reg.emplace<HBE::ECS::IDComponent>(e, id);
+                byUUID[id.uuid] = e;
 
                 HBE::ECS::TagComponent tag{};
                 tag.tag = name.empty() ? std::string("Entity_") + id.uuid.substr(0, 6) : name;
                 reg.emplace<HBE::ECS::TagComponent>(e, tag);
             }
 
+            const std::string parentUUID = ej.value("parent", "");
+            if (!parentUUID.empty()) parentLinks.emplace_back(e, parentUUID);
+
             // Transform
             if (comps.contains("Transform2D")) {
                 Transform2D t{};
@@ -395,8 +439,78 @@ namespace HBE::Renderer {
             }
         }
 
+        // Hierarchy: saved transforms are world poses, setParent turns them local
+        for (const auto& [child, parentUUID] : parentLinks) {
+            auto it = byUUID.find(parentUUID);
+            if (it == byUUID.end()) {
+                HBE::Core::LogWarn("SceneSerializer: unknown parent uuid: " + parentUUID);
+                continue;
+            }
+            scene.setParent(child, it->second);
+        }
+
         HBE::Core::LogInfo("Scene loaded: " + path);
         return true;
     }
 
+    bool SceneSerializer::loadPrefabFromFile(HBE::ECS::Prefab& prefab,
+        const std::string& path,
+        const SceneLoadCallbacks& cb,
+        std::string* outError)
+    {
+        std::string text;
+        if (!readAllText(path, text)) {
+            if (outError) *outError = "SceneSerializer: could not open: " + path;
+            return false;
+        }
+
+        json root;
+        try {
+            root = json::parse(text);
+        }
+        catch (...) {
+            if (outError) *outError = "SceneSerializer: invalid JSON: " + path;
+            return false;
+        }
+
+        const json comps = root.value("components", json::object());
+
+        prefab = HBE::ECS::Prefab(root.value("name", ""));
+
+        if (!prefab.name().empty()) {
+            HBE::ECS::TagComponent tag{};
+            tag.tag = prefab.name();
+            prefab.set<HBE::ECS::TagComponent>(tag);
+        }
+
+        // Transform (always present, like scene entities)
+        Transform2D t{};
+        if (comps.contains("Transform2D")) {
+            fromJsonTransform(comps["Transform2D"], t);
+        }
+        prefab.set<Transform2D>(t);
+
+        if (comps.contains("Sprite2D")) {
+            SpriteComponent2D sprite{};
+            if (!fromJsonSprite(comps["Sprite2D"], sprite, cb, outError)) {
+                return false;
+            }
+            prefab.set<SpriteComponent2D>(sprite);
+        }
+
+        if (comps.contains("Collider2D")) {
+            HBE::ECS::Collider2D c{};
+            fromJsonCollider(comps["Collider2D"], c);
+            prefab.set<HBE::ECS::Collider2D>(c);
+        }
+
+        if (comps.contains("RigidBody2D")) {
+            HBE::ECS::RigidBody2D r{};
+            fromJsonRigidBody(comps["RigidBody2D"], r);
+            prefab.set<HBE::ECS::RigidBody2D>(r);
+        }
+
+        HBE::Core::LogInfo("Prefab loaded: " + path);
+        return true;
+    }
 }
\ No newline at end of file
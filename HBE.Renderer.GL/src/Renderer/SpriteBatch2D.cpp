@@ -19,6 +19,7 @@ namespace HBE::Renderer {
 		m_drawCalls = 0;
 		m_quadsSubmitted = 0;
 		m_orderCounter = 0;
+		m_presorted = true;
 		m_quads.clear();
 	}
 
@@ -38,23 +39,24 @@ namespace HBE::Renderer {
 		q.order = m_orderCounter++;
 		emitQuadVertices(item, q.v);
 
+		// callers that submit in draw order (Scene2D does) let flush() skip the sort
+		if (m_presorted && !m_quads.empty() && quadLess(q, m_quads.back())) {
+			m_presorted = false;
+		}
+
 		m_quads.push_back(q);
 		m_quadsSubmitted++;
 	}
 
-	bool SpriteBatch2D::materialLess(const Quad& a, const Quad& b) {
-		// simple stable key: pointer compare.
-		// if later want more sharing: compare shader ptr, texture ptr, uniforms, etc.
-		return a.material < b.material;
-	}
-
 	void SpriteBatch2D::flush(const float* viewProj) {
 		if (m_quads.empty()) return;
 
 		initGL();
 
-		// sort by material so we can draw large runs per shader/texture
-		std::sort(m_quads.begin(), m_quads.end(), materialLess);
+		// draw order: layer, then material (long runs per shader/texture), then sortKey
+		if (!m_presorted) {
+			std::sort(m_quads.begin(), m_quads.end(), quadLess);
+		}
 
 		// one big stsaging buffer for up to m_maxQWuadsPerFlush quads
 		m_vertexStaging.clear();
@@ -94,7 +96,6 @@ namespace HBE::Renderer {
 
 			currentMat = q.material;
 		}
-		std::sort(m_quads.begin(), m_quads.end(), quadLess);
 		flushCurrent();
 	}
 
@@ -0,0 +1,118 @@
+#include "HBE/Renderer/StaticColliderGrid2D.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace HBE::Renderer {
+
+	void StaticColliderGrid2D::clear() {
+		m_boxes.clear();
+		m_ranges.clear();
+		m_cellStart.clear();
+		m_cellItems.clear();
+		m_cols = 0;
+		m_rows = 0;
+	}
+
+	void StaticColliderGrid2D::add(HBE::ECS::Entity e, float cx, float cy, float hx, float hy) {
+		// NaN/inf boxes can't be placed in any cell (and would stall build())
+		if (!std::isfinite(cx) || !std::isfinite(cy) || !std::isfinite(hx) || !std::isfinite(hy)) return;
+		m_boxes.push_back(Box{ cx, cy, std::fabs(hx), std::fabs(hy), e });
+	}
+
+	bool StaticColliderGrid2D::cellRange(float minX, float minY, float maxX, float maxY, int& x0, int& y0, int& x1, int& y1) const {
+		const float fx0 = std::floor((minX - m_originX) * m_invCell);
+		const float fy0 = std::floor((minY - m_originY) * m_invCell);
+		const float fx1 = std::floor((maxX - m_originX) * m_invCell);
+		const float fy1 = std::floor((maxY - m_originY) * m_invCell);
+
+		// also keeps NaN (e.g. a body with a broken transform) away from the int casts
+		if (!std::isfinite(fx0) || !std::isfinite(fy0) || !std::isfinite(fx1) || !std::isfinite(fy1)) return false;
+
+		if (fx1 < 0.0f || fy1 < 0.0f || fx0 >= (float)m_cols || fy0 >= (float)m_rows) return false;
+
+		x0 = (int)std::max(fx0, 0.0f);
+		y0 = (int)std::max(fy0, 0.0f);
+		x1 = (int)std::min(fx1, (float)(m_cols - 1));
+		y1 = (int)std::min(fy1, (float)(m_rows - 1));
+		return true;
+	}
+
+	void StaticColliderGrid2D::build() {
+		m_ranges.clear();
+		m_cellStart.clear();
+		m_cellItems.clear();
+		m_cols = 0;
+		m_rows = 0;
+
+		if (m_boxes.empty()) return;
+
+		float minX = m_boxes[0].cx - m_boxes[0].hx, maxX = m_boxes[0].cx + m_boxes[0].hx;
+		float minY = m_boxes[0].cy - m_boxes[0].hy, maxY = m_boxes[0].cy + m_boxes[0].hy;
+
+		for (const Box& b : m_boxes) {
+			minX = std::min(minX, b.cx - b.hx);
+			maxX = std::max(maxX, b.cx + b.hx);
+			minY = std::min(minY, b.cy - b.hy);
+			maxY = std::max(maxY, b.cy + b.hy);
+		}
+
+		// grow cells until the grid fits the budget (sparse worlds with far-off statics)
+		float cell = m_cellSize;
+		double cols = 0.0, rows = 0.0;
+		for (;;) {
+			cols = std::floor((maxX - minX) / cell) + 1.0;
+			rows = std::floor((maxY - minY) / cell) + 1.0;
+			if (cols * rows <= (double)maxCells) break;
+			cell *= 2.0f;
+
+			// extents too large for any float cell: one cell holding everything
+			if (!std::isfinite(cell)) {
+				cols = 1.0;
+				rows = 1.0;
+				break;
+			}
+		}
+
+		m_originX = minX;
+		m_originY = minY;
+		m_invCell = std::isfinite(cell) ? 1.0f / cell : 0.0f;
+		m_cols = (int)cols;
+		m_rows = (int)rows;
+
+		// counting sort of (cell, box) entries into the flat table
+		m_ranges.resize(m_boxes.size());
+		m_cellStart.assign(cellCount() + 1, 0u);
+
+		for (std::size_t i = 0; i < m_boxes.size(); ++i) {
+			const Box& b = m_boxes[i];
+			CellRange& r = m_ranges[i];
+			if (!cellRange(b.cx - b.hx, b.cy - b.hy, b.cx + b.hx, b.cy + b.hy, r.x0, r.y0, r.x1, r.y1)) {
+				r = CellRange{ 0, 0, 0, 0 }; // only in the single-cell fallback (extents overflow)
+			}
+
+			for (int y = r.y0; y <= r.y1; ++y) {
+				for (int x = r.x0; x <= r.x1; ++x) {
+					++m_cellStart[static_cast<std::size_t>(y) * m_cols + x + 1];
+				}
+			}
+		}
+
+		for (std::size_t c = 0; c < cellCount(); ++c) {
+			m_cellStart[c + 1] += m_cellStart[c];
+		}
+
+		m_cellItems.resize(m_cellStart.back());
+
+		std::vector<std::uint32_t> cursor(m_cellStart.begin(), m_cellStart.end() - 1);
+		for (std::size_t i = 0; i < m_boxes.size(); ++i) {
+			const CellRange& r = m_ranges[i];
+			for (int y = r.y0; y <= r.y1; ++y) {
+				for (int x = r.x0; x <= r.x1; ++x) {
+					m_cellItems[cursor[static_cast<std::size_t>(y) * m_cols + x]++] = static_cast<std::uint32_t>(i);
+				}
+			}
+		}
+	}
+
+}
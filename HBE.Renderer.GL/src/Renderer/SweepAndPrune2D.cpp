@@ -0,0 +1,98 @@
+#include "HBE/Renderer/SweepAndPrune2D.h"
+
+#include <algorithm>
+
+namespace HBE::Renderer {
+
+	void SweepAndPrune2D::begin() {
+		m_pending.clear();
+	}
+
+	void SweepAndPrune2D::add(HBE::ECS::Entity e, float minX, float minY, float maxX, float maxY) {
+		Proxy p;
+		p.minX = minX;
+		p.maxX = maxX;
+		p.minY = minY;
+		p.maxY = maxY;
+		p.slot = static_cast<std::uint32_t>(m_pending.size());
+		p.entity = e;
+		m_pending.push_back(p);
+	}
+
+	void SweepAndPrune2D::clear() {
+		m_order.clear();
+		m_pending.clear();
+		m_scratch.clear();
+		m_slotOf.clear();
+		m_lastSortMoves = 0;
+	}
+
+	void SweepAndPrune2D::findPairs(std::vector<Pair>& out) {
+		out.clear();
+
+		for (const Proxy& p : m_pending) {
+			if (p.entity >= m_slotOf.size()) m_slotOf.resize(static_cast<std::size_t>(p.entity) + 1, 0u);
+			m_slotOf[p.entity] = p.slot + 1;
+		}
+
+		// carry last frame's order over (fresh bounds), dropping bodies that are gone
+		m_scratch.clear();
+		for (const Proxy& old : m_order) {
+			if (old.entity >= m_slotOf.size()) continue;
+
+			const std::uint32_t s = m_slotOf[old.entity];
+			if (s == 0) continue;
+
+			m_scratch.push_back(m_pending[s - 1]);
+			m_slotOf[old.entity] = 0; // consumed
+		}
+
+		const std::size_t carried = m_scratch.size();
+
+		// whatever is still mapped is new this frame
+		for (const Proxy& p : m_pending) {
+			if (m_slotOf[p.entity] == 0) continue;
+			m_scratch.push_back(p);
+			m_slotOf[p.entity] = 0;
+		}
+
+		// carried part: nearly sorted, insertion sort
+		std::size_t moves = 0;
+		for (std::size_t i = 1; i < carried; ++i) {
+			const Proxy p = m_scratch[i];
+			std::size_t j = i;
+			while (j > 0 && m_scratch[j - 1].minX > p.minX) {
+				m_scratch[j] = m_scratch[j - 1];
+				--j;
+			}
+			if (j != i) {
+				m_scratch[j] = p;
+				moves += i - j;
+			}
+		}
+
+		// new bodies (spawns, first frame): sort on their own, then merge in
+		if (carried < m_scratch.size()) {
+			auto byMinX = [](const Proxy& a, const Proxy& b) { return a.minX < b.minX; };
+			std::sort(m_scratch.begin() + carried, m_scratch.end(), byMinX);
+			std::inplace_merge(m_scratch.begin(), m_scratch.begin() + carried, m_scratch.end(), byMinX);
+		}
+
+		m_order.swap(m_scratch);
+		m_lastSortMoves = moves;
+
+		// sweep: only bodies whose X interval starts inside ours can overlap
+		const std::size_t n = m_order.size();
+		for (std::size_t i = 0; i < n; ++i) {
+			const Proxy& a = m_order[i];
+
+			for (std::size_t j = i + 1; j < n && m_order[j].minX <= a.maxX; ++j) {
+				const Proxy& b = m_order[j];
+				if (b.minY > a.maxY || a.minY > b.maxY) continue;
+
+				out.push_back(a.slot < b.slot ? Pair{ a.slot, b.slot } : Pair{ b.slot, a.slot });
+			}
+		}
+	}
+
+}
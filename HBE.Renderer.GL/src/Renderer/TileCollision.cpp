@@ -1,9 +1,47 @@
 #include "HBE/Renderer/TileCollision.h"
+#include "HBE/Renderer/DynamicAABBTree2D.h"
+#include "HBE/Core/JobSystem.h"
 #include <cmath>
 #include <algorithm>
+#include <limits>
 
 namespace HBE::Renderer {
 
+    // The movers and raycasts below are written against a cell source: flags(tx, ty) ->
+    // TileCollisionGrid::Flags, the world tile size and the extent in tiles (everything
+    // outside is empty). GridCells reads a compiled grid (flat array, the fast path);
+    // LayerCells answers from the layer and its tileset (set/map lookups per tile).
+    namespace {
+
+        struct GridCells {
+            const TileCollisionGrid& grid;
+
+            std::uint8_t flags(int tx, int ty) const { return grid.at(tx, ty); }
+            float tileW() const { return grid.tileW(); }
+            float tileH() const { return grid.tileH(); }
+            int width() const { return grid.width(); }
+            int height() const { return grid.height(); }
+        };
+
+        struct LayerCells {
+            const TileMap& map;
+            const TileMapLayer& layer;
+
+            std::uint8_t flags(int tx, int ty) const {
+                const int tileId = layer.at(tx, ty);
+                if (tileId == 0) return 0;
+                return TileCollisionGrid::FlagsOf(map.tilesets[layer.tilesetIndex], tileId);
+            }
+            float tileW() const { return map.worldTileW(); }
+            float tileH() const { return map.worldTileH(); }
+            int width() const { return layer.w; }
+            int height() const { return layer.h; }
+        };
+
+        constexpr std::uint8_t BlockMask = TileCollisionGrid::BlockMask;
+
+    }
+
     static void getExtents(const AABB& b, float& minX, float& minY, float& maxX, float& maxY) {
         const float hw = b.w * 0.5f;
         const float hh = b.h * 0.5f;
@@ -13,12 +51,13 @@ namespace HBE::Renderer {
         maxY = b.cy + hh;
     }
 
-    static bool overlapsSolidLike(const TileMap& map, const TileMapLayer& layer, const AABB& box) {
+    template<typename Cells>
+    static bool overlapsSolidLike(const Cells& cells, const AABB& box) {
         float minX, minY, maxX, maxY;
         getExtents(box, minX, minY, maxX, maxY);
 
-        const float tw = map.worldTileW();
-        const float th = map.worldTileH();
+        const float tw = cells.tileW();
+        const float th = cells.tileH();
 
         const int minTX = (int)std::floor(minX / tw);
         const int maxTX = (int)std::floor((maxX - 0.001f) / tw);
@@ -27,11 +66,7 @@ namespace HBE::Renderer {
 
         for (int ty = minTY; ty <= maxTY; ++ty) {
             for (int tx = minTX; tx <= maxTX; ++tx) {
-                const int tileId = layer.at(tx, ty);
-                if (tileId == 0) continue;
-
-                const auto& ts = map.tilesets[layer.tilesetIndex];
-                if (ts.isSolid(tileId) || ts.slopeType(tileId) != SlopeType::None) {
+                if (cells.flags(tx, ty) & BlockMask) {
                     return true;
                 }
             }
@@ -62,9 +97,21 @@ namespace HBE::Renderer {
         return ts.slopeType(tileId);
     }
 
+    bool TileCollision::isSolidTile(const TileCollisionGrid& grid, int tx, int ty) {
+        return grid.isSolid(tx, ty);
+    }
+
+    bool TileCollision::isOneWayTile(const TileCollisionGrid& grid, int tx, int ty) {
+        return grid.isOneWay(tx, ty);
+    }
+
+    SlopeType TileCollision::slopeTypeAt(const TileCollisionGrid& grid, int tx, int ty) {
+        return grid.slopeType(tx, ty);
+    }
+
+    template<typename Cells>
     static void resolveX(
-        const TileMap& map,
-        const TileMapLayer& layer,
+        const Cells& cells,
         AABB& box,
         float& velX,
         MoveResult2D& out,
@@ -75,8 +122,8 @@ namespace HBE::Renderer {
         float minX, minY, maxX, maxY;
         getExtents(box, minX, minY, maxX, maxY);
 
-        const float tw = map.worldTileW();
-        const float th = map.worldTileH();
+        const float tw = cells.tileW();
+        const float th = cells.tileH();
 
         const int minTY = (int)std::floor(minY / th);
         const int maxTY = (int)std::floor((maxY - 0.001f) / th);
@@ -85,19 +132,14 @@ namespace HBE::Renderer {
             const int tx = (int)std::floor((maxX - 0.001f) / tw);
 
             for (int ty = minTY; ty <= maxTY; ++ty) {
-                const int tileId = layer.at(tx, ty);
-                if (tileId == 0) continue;
-
-                const auto& ts = map.tilesets[layer.tilesetIndex];
-                const bool blocks = ts.isSolid(tileId) || ts.slopeType(tileId) != SlopeType::None;
-                if (!blocks) continue;
+                if (!(cells.flags(tx, ty) & BlockMask)) continue;
 
                 // Step-up attempt: raise, then see if we can exist there without overlap
                 if (maxStepUp > 0.0f) {
                     AABB stepBox = box;
                     stepBox.cy += maxStepUp;
 
-                    if (!overlapsSolidLike(map, layer, stepBox)) {
+                    if (!overlapsSolidLike(cells, stepBox)) {
                         box = stepBox;
                         out.steppedUp = true;
                         return;
@@ -115,18 +157,13 @@ namespace HBE::Renderer {
             const int tx = (int)std::floor(minX / tw);
 
             for (int ty = minTY; ty <= maxTY; ++ty) {
-                const int tileId = layer.at(tx, ty);
-                if (tileId == 0) continue;
-
-                const auto& ts = map.tilesets[layer.tilesetIndex];
-                const bool blocks = ts.isSolid(tileId) || ts.slopeType(tileId) != SlopeType::None;
-                if (!blocks) continue;
+                if (!(cells.flags(tx, ty) & BlockMask)) continue;
 
                 if (maxStepUp > 0.0f) {
                     AABB stepBox = box;
                     stepBox.cy += maxStepUp;
 
-                    if (!overlapsSolidLike(map, layer, stepBox)) {
+                    if (!overlapsSolidLike(cells, stepBox)) {
                         box = stepBox;
                         out.steppedUp = true;
                         return;
@@ -142,9 +179,9 @@ namespace HBE::Renderer {
         }
     }
 
+    template<typename Cells>
     static void resolveY(
-        const TileMap& map,
-        const TileMapLayer& layer,
+        const Cells& cells,
         AABB& box,
         float& velY,
         MoveResult2D& out,
@@ -156,8 +193,8 @@ namespace HBE::Renderer {
         float minX, minY, maxX, maxY;
         getExtents(box, minX, minY, maxX, maxY);
 
-        const float tw = map.worldTileW();
-        const float th = map.worldTileH();
+        const float tw = cells.tileW();
+        const float th = cells.tileH();
 
         const int minTX = (int)std::floor(minX / tw);
         const int maxTX = (int)std::floor((maxX - 0.001f) / tw);
@@ -166,12 +203,7 @@ namespace HBE::Renderer {
             const int ty = (int)std::floor((maxY - 0.001f) / th);
 
             for (int tx = minTX; tx <= maxTX; ++tx) {
-                const int tileId = layer.at(tx, ty);
-                if (tileId == 0) continue;
-
-                const auto& ts = map.tilesets[layer.tilesetIndex];
-                const bool blocks = ts.isSolid(tileId) || ts.slopeType(tileId) != SlopeType::None;
-                if (!blocks) continue;
+                if (!(cells.flags(tx, ty) & BlockMask)) continue;
 
                 // Clamp against the tile's bottom face
                 box.cy = ty * th - box.h * 0.5f;
@@ -186,14 +218,12 @@ namespace HBE::Renderer {
             const float newBottom = minY;
 
             for (int tx = minTX; tx <= maxTX; ++tx) {
-                const int tileId = layer.at(tx, ty);
-                if (tileId == 0) continue;
+                const std::uint8_t f = cells.flags(tx, ty);
+                if (f == 0) continue;
 
-                const auto& ts = map.tilesets[layer.tilesetIndex];
-
-                const bool isSolid = ts.isSolid(tileId);
-                const bool isSlope = ts.slopeType(tileId) != SlopeType::None;
-                const bool isOneWay = enableOneWay && ts.isOneWay(tileId);
+                const bool isSolid = (f & TileCollisionGrid::Solid) != 0;
+                const bool isSlope = (f & TileCollisionGrid::SlopeMask) != 0;
+                const bool isOneWay = enableOneWay && (f & TileCollisionGrid::OneWay) != 0;
 
                 if (!isSolid && !isSlope && !isOneWay) continue;
 
@@ -226,9 +256,9 @@ namespace HBE::Renderer {
         }
     }
 
+    template<typename Cells>
     static void applySlopeSnap(
-        const TileMap& map,
-        const TileMapLayer& layer,
+        const Cells& cells,
         AABB& box,
         float& velY,
         MoveResult2D& out
@@ -239,8 +269,8 @@ namespace HBE::Renderer {
         float minX, minY, maxX, maxY;
         getExtents(box, minX, minY, maxX, maxY);
 
-        const float tw = map.worldTileW();
-        const float th = map.worldTileH();
+        const float tw = cells.tileW();
+        const float th = cells.tileH();
 
         const int minTX = (int)std::floor(minX / tw);
         const int maxTX = (int)std::floor((maxX - 0.001f) / tw);
@@ -253,7 +283,7 @@ namespace HBE::Renderer {
         bool found = false;
 
         for (int tx = minTX; tx <= maxTX; ++tx) {
-            const SlopeType st = TileCollision::slopeTypeAt(map, layer, tx, ty);
+            const SlopeType st = TileCollisionGrid::SlopeOf(cells.flags(tx, ty));
             if (st == SlopeType::None) continue;
 
             const float tileLeft = tx * tw;
@@ -307,9 +337,15 @@ namespace HBE::Renderer {
         (void)TileCollision::moveAndCollideEx(map, layer, box, velX, velY, dt, 0.0f, false, false, prevBottom);
     }
 
-    MoveResult2D TileCollision::moveAndCollideEx(
-        const TileMap& map,
-        const TileMapLayer& layer,
+    // fraction of an axis move that was actually travelled
+    static float travelled(float moved, float intended) {
+        if (intended == 0.0f) return 0.0f;
+        return std::clamp(moved / intended, 0.0f, 1.0f);
+    }
+
+    template<typename Cells>
+    static MoveResult2D moveAndCollideCells(
+        const Cells& cells,
         AABB& box,
         float& velX,
         float& velY,
@@ -322,17 +358,364 @@ namespace HBE::Renderer {
         MoveResult2D res{};
 
         // X then Y (classic platformer)
-        box.cx += velX * dt;
-        resolveX(map, layer, box, velX, res, maxStepUp);
+        const float dx = velX * dt;
+        const float startX = box.cx;
+        box.cx += dx;
+        resolveX(cells, box, velX, res, maxStepUp);
+        if (res.hitX) res.timeOfImpactX = travelled(box.cx - startX, dx);
+
+        const float dy = velY * dt;
+        const float startY = box.cy;
+        box.cy += dy;
+        resolveY(cells, box, velY, res, enableOneWay, oneWayPrevBottom);
+        if (res.hitY) res.timeOfImpactY = travelled(box.cy - startY, dy);
+
+        if (enableSlopes) {
+            applySlopeSnap(cells, box, velY, res);
+        }
+
+        return res;
+    }
+
+    // center that puts a box's low edge at 'edge' without rounding into the tile below
+    static float placeLowEdge(float edge, float half) {
+        float c = edge + half;
+        while (c - half < edge) c = std::nextafter(c, edge + 2.0f * half + 1.0f);
+        return c;
+    }
+
+    // Swept version of resolveX: the leading edge walks the tile columns it enters
+    // during the move (a 1D DDA; the mover is axis-separated), and each column gets
+    // the test resolveX does at the end of a discrete move, with the box placed
+    // where its edge just fills that column. The first blocking column stops the box
+    // at its face; a step-up raises it and the walk continues at the new height.
+    // A move that enters at most one new column performs exactly the discrete move.
+    template<typename Cells>
+    static void sweepX(const Cells& cells, AABB& box, float& velX, float dx, MoveResult2D& out, float maxStepUp) {
+        const float tw = cells.tileW();
+        const float half = box.w * 0.5f;
+        const int lastCol = cells.width() - 1;
+
+        // the final placement is computed like the discrete move (same rounding)
+        const float endCx = box.cx + dx;
+
+        if (velX > 0.0f) {
+            const float e0 = box.cx + half;
+            const float e1 = e0 + dx;
+            const int c0 = (int)std::floor((e0 - 0.001f) / tw);
+            const int c1 = (int)std::floor((e1 - 0.001f) / tw);
+            if (c1 - c0 > 1) out.swept = true;
+
+            // columns outside the layer are empty
+            const int first = std::max(std::min(c0 + 1, c1), 0);
+            const int last = std::min(c1, lastCol);
+
+            for (int c = first; c <= last; ++c) {
+                const float edge = (float)(c + 1) * tw;
+                box.cx = (edge < e1) ? edge - half : endCx;
+                resolveX(cells, box, velX, out, maxStepUp);
+                if (out.hitX) return;
+            }
+            box.cx = endCx;
+        }
+        else if (velX < 0.0f) {
+            const float e0 = box.cx - half;
+            const float e1 = e0 + dx;
+            const int c0 = (int)std::floor(e0 / tw);
+            const int c1 = (int)std::floor(e1 / tw);
+            if (c0 - c1 > 1) out.swept = true;
+
+            const int first = std::min(std::max(c0 - 1, c1), lastCol);
+            const int last = std::max(c1, 0);
+
+            for (int c = first; c >= last; --c) {
+                const float edge = (float)c * tw;
+                box.cx = (edge > e1) ? placeLowEdge(edge, half) : endCx;
+                resolveX(cells, box, velX, out, maxStepUp);
+                if (out.hitX) return;
+            }
+            box.cx = endCx;
+        }
+    }
+
+    // Same walk over rows for resolveY (ceilings going up, floors and one-way tops going down).
+    template<typename Cells>
+    static void sweepY(const Cells& cells, AABB& box, float& velY, float dy, MoveResult2D& out, bool enableOneWay, float prevBottom) {
+        const float th = cells.tileH();
+        const float half = box.h * 0.5f;
+        const int lastRow = cells.height() - 1;
+
+        const float endCy = box.cy + dy;
+
+        if (velY > 0.0f) {
+            const float e0 = box.cy + half;
+            const float e1 = e0 + dy;
+            const int r0 = (int)std::floor((e0 - 0.001f) / th);
+            const int r1 = (int)std::floor((e1 - 0.001f) / th);
+            if (r1 - r0 > 1) out.swept = true;
+
+            const int first = std::max(std::min(r0 + 1, r1), 0);
+            const int last = std::min(r1, lastRow);
+
+            for (int r = first; r <= last; ++r) {
+                const float edge = (float)(r + 1) * th;
+                box.cy = (edge < e1) ? edge - half : endCy;
+                resolveY(cells, box, velY, out, enableOneWay, prevBottom);
+                if (out.hitY) return;
+            }
+            box.cy = endCy;
+        }
+        else if (velY < 0.0f) {
+            const float e0 = box.cy - half;
+            const float e1 = e0 + dy;
+            const int r0 = (int)std::floor(e0 / th);
+            const int r1 = (int)std::floor(e1 / th);
+            if (r0 - r1 > 1) out.swept = true;
+
+            const int first = std::min(std::max(r0 - 1, r1), lastRow);
+            const int last = std::max(r1, 0);
+
+            for (int r = first; r >= last; --r) {
+                const float edge = (float)r * th;
+                box.cy = (edge > e1) ? placeLowEdge(edge, half) : endCy;
+                resolveY(cells, box, velY, out, enableOneWay, prevBottom);
+                if (out.hitY) return;
+            }
+            box.cy = endCy;
+        }
+    }
 
-        box.cy += velY * dt;
-        resolveY(map, layer, box, velY, res, enableOneWay, oneWayPrevBottom);
+    template<typename Cells>
+    static MoveResult2D moveAndCollideSweptCells(
+        const Cells& cells,
+        AABB& box,
+        float& velX,
+        float& velY,
+        float dt,
+        float maxStepUp,
+        bool enableOneWay,
+        bool enableSlopes,
+        float oneWayPrevBottom
+    ) {
+        MoveResult2D res{};
+
+        const float dx = velX * dt;
+        const float startX = box.cx;
+        sweepX(cells, box, velX, dx, res, maxStepUp);
+        if (res.hitX) res.timeOfImpactX = travelled(box.cx - startX, dx);
+
+        const float dy = velY * dt;
+        const float startY = box.cy;
+        sweepY(cells, box, velY, dy, res, enableOneWay, oneWayPrevBottom);
+        if (res.hitY) res.timeOfImpactY = travelled(box.cy - startY, dy);
 
         if (enableSlopes) {
-            applySlopeSnap(map, layer, box, velY, res);
+            applySlopeSnap(cells, box, velY, res);
         }
 
         return res;
     }
 
+    MoveResult2D TileCollision::moveAndCollideEx(
+        const TileMap& map,
+        const TileMapLayer& layer,
+        AABB& box,
+        float& velX,
+        float& velY,
+        float dt,
+        float maxStepUp,
+        bool enableOneWay,
+        bool enableSlopes,
+        float oneWayPrevBottom
+    ) {
+        return moveAndCollideCells(LayerCells{ map, layer }, box, velX, velY, dt, maxStepUp, enableOneWay, enableSlopes, oneWayPrevBottom);
+    }
+
+    MoveResult2D TileCollision::moveAndCollideEx(
+        const TileCollisionGrid& grid,
+        AABB& box,
+        float& velX,
+        float& velY,
+        float dt,
+        float maxStepUp,
+        bool enableOneWay,
+        bool enableSlopes,
+        float oneWayPrevBottom
+    ) {
+        return moveAndCollideCells(GridCells{ grid }, box, velX, velY, dt, maxStepUp, enableOneWay, enableSlopes, oneWayPrevBottom);
+    }
+
+    MoveResult2D TileCollision::moveAndCollideSwept(
+        const TileMap& map,
+        const TileMapLayer& layer,
+        AABB& box,
+        float& velX,
+        float& velY,
+        float dt,
+        float maxStepUp,
+        bool enableOneWay,
+        bool enableSlopes,
+        float oneWayPrevBottom
+    ) {
+        return moveAndCollideSweptCells(LayerCells{ map, layer }, box, velX, velY, dt, maxStepUp, enableOneWay, enableSlopes, oneWayPrevBottom);
+    }
+
+    MoveResult2D TileCollision::moveAndCollideSwept(
+        const TileCollisionGrid& grid,
+        AABB& box,
+        float& velX,
+        float& velY,
+        float dt,
+        float maxStepUp,
+        bool enableOneWay,
+        bool enableSlopes,
+        float oneWayPrevBottom
+    ) {
+        return moveAndCollideSweptCells(GridCells{ grid }, box, velX, velY, dt, maxStepUp, enableOneWay, enableSlopes, oneWayPrevBottom);
+    }
+
+    // Tile walk along the segment (Amanatides-Woo DDA) over the cells it crosses, in order.
+    // Solid tiles stop it at the face it entered through; one-way tiles only when entered
+    // through their top (the ray goes down); slope tiles are the triangle under their
+    // diagonal, hit on the face it entered through or on the diagonal.
+    template<typename Cells>
+    static bool raycastCells(const Cells& cells, float x0, float y0, float x1, float y1, TileRaycastHit2D& out, bool hitOneWay) {
+        out = TileRaycastHit2D{};
+
+        const int w = cells.width();
+        const int h = cells.height();
+        if (w <= 0 || h <= 0) return false;
+
+        const float tw = cells.tileW();
+        const float th = cells.tileH();
+        const float dx = x1 - x0;
+        const float dy = y1 - y0;
+
+        // start where the segment enters the layer (nothing to hit outside)
+        const Bounds2D layerBounds{ 0.0f, 0.0f, (float)w * tw, (float)h * th };
+
+        float t, faceNx, faceNy;
+        if (!SegmentVsBounds(layerBounds, x0, y0, dx, dy, 1.0f, t, faceNx, faceNy)) return false;
+
+        const float sx = x0 + dx * t;
+        const float sy = y0 + dy * t;
+
+        // a start on a tile edge belongs to the tile the ray goes into
+        int cx = (int)std::floor(sx / tw);
+        int cy = (int)std::floor(sy / th);
+        if (dx < 0.0f && (float)cx * tw == sx) --cx;
+        if (dy < 0.0f && (float)cy * th == sy) --cy;
+        cx = std::clamp(cx, 0, w - 1);
+        cy = std::clamp(cy, 0, h - 1);
+
+        constexpr float inf = std::numeric_limits<float>::infinity();
+
+        const int stepX = (dx > 0.0f) ? 1 : (dx < 0.0f ? -1 : 0);
+        const int stepY = (dy > 0.0f) ? 1 : (dy < 0.0f ? -1 : 0);
+
+        // fractions along the segment: per tile, and to the next column/row boundary
+        const float tDeltaX = (stepX != 0) ? tw / std::fabs(dx) : inf;
+        const float tDeltaY = (stepY != 0) ? th / std::fabs(dy) : inf;
+        float tNextX = (stepX > 0) ? ((float)(cx + 1) * tw - x0) / dx : (stepX < 0 ? ((float)cx * tw - x0) / dx : inf);
+        float tNextY = (stepY > 0) ? ((float)(cy + 1) * th - y0) / dy : (stepY < 0 ? ((float)cy * th - y0) / dy : inf);
+
+        auto report = [&](float tHit, float nx, float ny) {
+            out.hit = true;
+            out.tileX = cx;
+            out.tileY = cy;
+            out.fraction = tHit;
+            out.distance = tHit * std::sqrt(dx * dx + dy * dy);
+            out.pointX = x0 + dx * tHit;
+            out.pointY = y0 + dy * tHit;
+            out.normalX = nx;
+            out.normalY = ny;
+            return true;
+            };
+
+        for (;;) {
+            const std::uint8_t f = cells.flags(cx, cy);
+
+            if (f & TileCollisionGrid::Solid) {
+                return report(t, faceNx, faceNy);
+            }
+
+            if (f & TileCollisionGrid::SlopeMask) {
+                // height above the diagonal (negative = inside the triangle) along the segment
+                const bool leftUp = (f & TileCollisionGrid::SlopeLeftUp) != 0;
+                const float left = (float)cx * tw;
+                const float bottom = (float)cy * th;
+
+                auto above = [&](float tt) {
+                    const float lx = std::clamp(x0 + dx * tt - left, 0.0f, tw);
+                    const float surface = leftUp ? (lx / tw) * th : (1.0f - lx / tw) * th;
+                    return (y0 + dy * tt - bottom) - surface;
+                    };
+
+                const float tExit = std::min(std::min(tNextX, tNextY), 1.0f);
+                const float g0 = above(t);
+                const float g1 = above(tExit);
+
+                if (g0 <= 0.0f) {
+                    return report(t, faceNx, faceNy);
+                }
+                if (g1 <= 0.0f) {
+                    const float len = std::sqrt(tw * tw + th * th);
+                    const float nx = leftUp ? -th / len : th / len;
+                    return report(t + (tExit - t) * (g0 / (g0 - g1)), nx, tw / len);
+                }
+            }
+            else if (hitOneWay && (f & TileCollisionGrid::OneWay) && faceNy > 0.0f) {
+                return report(t, faceNx, faceNy);
+            }
+
+            // next tile
+            if (tNextX < tNextY) {
+                if (tNextX > 1.0f) break;
+                t = tNextX;
+                tNextX += tDeltaX;
+                cx += stepX;
+                faceNx = (float)-stepX;
+                faceNy = 0.0f;
+            }
+            else {
+                if (tNextY > 1.0f) break;
+                t = tNextY;
+                tNextY += tDeltaY;
+                cy += stepY;
+                faceNx = 0.0f;
+                faceNy = (float)-stepY;
+            }
+
+            if (cx < 0 || cy < 0 || cx >= w || cy >= h) break;
+        }
+
+        return false;
+    }
+
+    bool TileCollision::raycast(const TileMap& map, const TileMapLayer& layer, float x0, float y0, float x1, float y1, TileRaycastHit2D& outHit, bool hitOneWay) {
+        return raycastCells(LayerCells{ map, layer }, x0, y0, x1, y1, outHit, hitOneWay);
+    }
+
+    bool TileCollision::raycast(const TileCollisionGrid& grid, float x0, float y0, float x1, float y1, TileRaycastHit2D& outHit, bool hitOneWay) {
+        return raycastCells(GridCells{ grid }, x0, y0, x1, y1, outHit, hitOneWay);
+    }
+
+    void TileCollision::raycastBatch(const TileCollisionGrid& grid, const TileRay2D* rays, std::size_t count, TileRaycastHit2D* outHits, bool hitOneWay) {
+        auto run = [&](std::size_t begin, std::size_t end) {
+            const GridCells cells{ grid };
+            for (std::size_t i = begin; i < end; ++i) {
+                const TileRay2D& r = rays[i];
+                raycastCells(cells, r.x0, r.y0, r.x1, r.y1, outHits[i], hitOneWay);
+            }
+            };
+
+        HBE::Core::JobSystem* jobs = HBE::Core::JobSystem::Get();
+        if (!jobs) {
+            run(0, count);
+            return;
+        }
+
+        jobs->parallelFor(count, 64, run);
+    }
+
 } // namespace HBE::Renderer
\ No newline at end of file
@@ -0,0 +1,118 @@
+#include "HBE/Renderer/TileCollisionGrid.h"
+#include "HBE/Core/Log.h"
+
+#include <algorithm>
+
+namespace HBE::Renderer {
+
+	using HBE::Core::LogError;
+
+	std::uint8_t TileCollisionGrid::FlagsOf(const TileMapTileset& ts, int tileId) {
+		if (tileId == 0) return 0;
+
+		std::uint8_t f = 0;
+		if (ts.isSolid(tileId)) f |= Solid;
+		if (ts.isOneWay(tileId)) f |= OneWay;
+
+		switch (ts.slopeType(tileId)) {
+		case SlopeType::LeftUp: f |= SlopeLeftUp; break;
+		case SlopeType::RightUp: f |= SlopeRightUp; break;
+		default: break;
+		}
+		return f;
+	}
+
+	void TileCollisionGrid::clear() {
+		m_cells.clear();
+		m_w = 0;
+		m_h = 0;
+		++m_version;
+	}
+
+	void TileCollisionGrid::build(const TileMap& map, const TileMapLayer& layer) {
+		m_cells.clear();
+		m_w = 0;
+		m_h = 0;
+		merge(map, layer);
+	}
+
+	void TileCollisionGrid::merge(const TileMap& map, const TileMapLayer& layer) {
+		++m_version;
+
+		m_tileW = map.worldTileW();
+		m_tileH = map.worldTileH();
+
+		if (layer.tilesetIndex < 0 || layer.tilesetIndex >= (int)map.tilesets.size()) {
+			LogError("TileCollisionGrid: layer '" + layer.name + "' has no valid tileset, skipped.");
+			return;
+		}
+
+		if ((std::size_t)layer.w * (std::size_t)layer.h > layer.data.size()) {
+			LogError("TileCollisionGrid: layer '" + layer.name + "' data is smaller than its size, skipped.");
+			return;
+		}
+
+		// grow to fit (rows keep their cells)
+		const int w = std::max(m_w, layer.w);
+		const int h = std::max(m_h, layer.h);
+		if (w != m_w || h != m_h) {
+			std::vector<std::uint8_t> grown(static_cast<std::size_t>(w) * h, 0);
+			for (int y = 0; y < m_h; ++y) {
+				std::copy_n(m_cells.begin() + static_cast<std::size_t>(y) * m_w, m_w, grown.begin() + static_cast<std::size_t>(y) * w);
+			}
+			m_cells.swap(grown);
+			m_w = w;
+			m_h = h;
+		}
+
+		// one tileset lookup per distinct tile id (table by id unless ids are huge)
+		const TileMapTileset& ts = map.tilesets[layer.tilesetIndex];
+		const int maxId = layer.data.empty() ? 0 : std::max(0, *std::max_element(layer.data.begin(), layer.data.end()));
+		constexpr int maxTableId = 1 << 16;
+
+		std::vector<std::uint8_t> flagsOf;
+		if (maxId <= maxTableId) {
+			flagsOf.assign(static_cast<std::size_t>(maxId) + 1, 0);
+			for (int id = 1; id <= maxId; ++id) flagsOf[id] = FlagsOf(ts, id);
+		}
+
+		for (int y = 0; y < layer.h; ++y) {
+			const int* src = layer.data.data() + static_cast<std::size_t>(y) * layer.w;
+			std::uint8_t* dst = m_cells.data() + static_cast<std::size_t>(y) * m_w;
+
+			for (int x = 0; x < layer.w; ++x) {
+				const int id = src[x];
+				if (id <= 0) continue;
+				dst[x] |= flagsOf.empty() ? FlagsOf(ts, id) : flagsOf[id];
+			}
+		}
+	}
+
+	void TileCollisionGrid::rebuildRegion(const TileMap& map, const std::vector<const TileMapLayer*>& layers, int x0, int y0, int x1, int y1) {
+		x0 = std::max(x0, 0);
+		y0 = std::max(y0, 0);
+		x1 = std::min(x1, m_w - 1);
+		y1 = std::min(y1, m_h - 1);
+		if (x0 > x1 || y0 > y1) return;
+
+		++m_version;
+
+		for (int y = y0; y <= y1; ++y) {
+			std::uint8_t* row = m_cells.data() + static_cast<std::size_t>(y) * m_w;
+			std::fill(row + x0, row + x1 + 1, std::uint8_t{ 0 });
+		}
+
+		for (const TileMapLayer* layer : layers) {
+			if (!layer || layer->tilesetIndex < 0 || layer->tilesetIndex >= (int)map.tilesets.size()) continue;
+
+			const TileMapTileset& ts = map.tilesets[layer->tilesetIndex];
+			for (int y = y0; y <= y1; ++y) {
+				std::uint8_t* row = m_cells.data() + static_cast<std::size_t>(y) * m_w;
+				for (int x = x0; x <= x1; ++x) {
+					row[x] |= FlagsOf(ts, layer->at(x, y));
+				}
+			}
+		}
+	}
+
+}
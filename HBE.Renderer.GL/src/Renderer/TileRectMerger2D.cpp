@@ -0,0 +1,138 @@
+#include "HBE/Renderer/TileRectMerger2D.h"
+
+#include <algorithm>
+
+namespace HBE::Renderer {
+
+	void TileRectMerger2D::clear() {
+		m_removed.clear();
+		for (int id = 0; id < (int)m_rects.size(); ++id) {
+			if (alive(id)) m_removed.push_back(id);
+		}
+		m_added.clear();
+
+		m_rects.clear();
+		m_freeIds.clear();
+		m_owner.clear();
+		m_count = 0;
+		m_w = 0;
+		m_h = 0;
+	}
+
+	bool TileRectMerger2D::covered(const TileCollisionGrid& grid, int x, int y) const {
+		return (grid.at(x, y) & m_mask) != 0;
+	}
+
+	Bounds2D TileRectMerger2D::worldBounds(int id) const {
+		const Rect& r = m_rects[id];
+		return Bounds2D{
+			(float)r.x * m_tileW, (float)r.y * m_tileH,
+			(float)(r.x + r.w) * m_tileW, (float)(r.y + r.h) * m_tileH
+		};
+	}
+
+	void TileRectMerger2D::build(const TileCollisionGrid& grid, std::uint8_t mask) {
+		clear(); // fills m_removed with the previous rectangles
+
+		m_mask = mask;
+		m_w = grid.width();
+		m_h = grid.height();
+		m_tileW = grid.tileW();
+		m_tileH = grid.tileH();
+		m_owner.assign(static_cast<std::size_t>(m_w) * m_h, None);
+
+		mergeRegion(grid, 0, 0, m_w - 1, m_h - 1);
+	}
+
+	void TileRectMerger2D::removeRect(int id) {
+		const Rect r = m_rects[id];
+		for (int y = r.y; y < r.y + r.h; ++y) {
+			std::fill_n(m_owner.begin() + static_cast<std::size_t>(y) * m_w + r.x, r.w, None);
+		}
+
+		m_rects[id] = Rect{};
+		m_freeIds.push_back(id);
+		--m_count;
+		m_removed.push_back(id);
+	}
+
+	void TileRectMerger2D::update(const TileCollisionGrid& grid, int x0, int y0, int x1, int y1) {
+		if (grid.width() != m_w || grid.height() != m_h) {
+			build(grid, m_mask);
+			return;
+		}
+
+		m_added.clear();
+		m_removed.clear();
+		m_tileW = grid.tileW();
+		m_tileH = grid.tileH();
+
+		x0 = std::max(x0, 0);
+		y0 = std::max(y0, 0);
+		x1 = std::min(x1, m_w - 1);
+		y1 = std::min(y1, m_h - 1);
+		if (x0 > x1 || y0 > y1) return;
+
+		// dissolve every rectangle touching the region; their tiles and the region's get re-merged
+		int bx0 = x0, by0 = y0, bx1 = x1, by1 = y1;
+		std::vector<int> dissolve;
+		query(x0, y0, x1, y1, [&](int id, const Rect& r) {
+			bx0 = std::min(bx0, r.x);
+			by0 = std::min(by0, r.y);
+			bx1 = std::max(bx1, r.x + r.w - 1);
+			by1 = std::max(by1, r.y + r.h - 1);
+			dissolve.push_back(id);
+			});
+
+		for (int id : dissolve) removeRect(id);
+
+		// tiles outside the dissolved rectangles are still owned, so merging the bounding
+		// box only picks up the freed and changed tiles
+		mergeRegion(grid, bx0, by0, bx1, by1);
+	}
+
+	void TileRectMerger2D::mergeRegion(const TileCollisionGrid& grid, int x0, int y0, int x1, int y1) {
+		auto isFree = [&](int x, int y) {
+			return m_owner[static_cast<std::size_t>(y) * m_w + x] == None && covered(grid, x, y);
+			};
+
+		for (int y = y0; y <= y1; ++y) {
+			for (int x = x0; x <= x1; ++x) {
+				if (!isFree(x, y)) continue;
+
+				// grow right, then up while the whole span is free
+				int w = 1;
+				while (x + w <= x1 && isFree(x + w, y)) ++w;
+
+				int h = 1;
+				while (y + h <= y1) {
+					bool rowFree = true;
+					for (int i = 0; i < w && rowFree; ++i) rowFree = isFree(x + i, y + h);
+					if (!rowFree) break;
+					++h;
+				}
+
+				int id;
+				if (!m_freeIds.empty()) {
+					id = m_freeIds.back();
+					m_freeIds.pop_back();
+				}
+				else {
+					id = (int)m_rects.size();
+					m_rects.emplace_back();
+				}
+
+				m_rects[id] = Rect{ x, y, w, h };
+				++m_count;
+				m_added.push_back(id);
+
+				for (int ry = y; ry < y + h; ++ry) {
+					std::fill_n(m_owner.begin() + static_cast<std::size_t>(ry) * m_w + x, w, id);
+				}
+
+				x += w - 1;
+			}
+		}
+	}
+
+}
@@ -0,0 +1,133 @@
+#include "HBE/Renderer/TransformHierarchy2D.h"
+#include "HBE/ECS/Registry.h"
+#include "HBE/ECS/Components.h"
+
+#include <cmath>
+
+namespace HBE::Renderer {
+
+	static WorldTransform2D toWorld(const Transform2D& t) {
+		WorldTransform2D w;
+		w.posX = t.posX;
+		w.posY = t.posY;
+		w.rotation = t.rotation;
+		w.scaleX = t.scaleX;
+		w.scaleY = t.scaleY;
+		return w;
+	}
+
+	static bool sameTransform(const Transform2D& a, const Transform2D& b) {
+		return a.posX == b.posX && a.posY == b.posY && a.rotation == b.rotation
+			&& a.scaleX == b.scaleX && a.scaleY == b.scaleY;
+	}
+
+	WorldTransform2D TransformHierarchy2D::compose(const WorldTransform2D& parent, const Transform2D& local) {
+		const float c = std::cos(parent.rotation);
+		const float s = std::sin(parent.rotation);
+
+		const float lx = local.posX * parent.scaleX;
+		const float ly = local.posY * parent.scaleY;
+
+		WorldTransform2D w;
+		w.posX = parent.posX + lx * c - ly * s;
+		w.posY = parent.posY + lx * s + ly * c;
+		w.rotation = parent.rotation + local.rotation;
+		w.scaleX = parent.scaleX * local.scaleX;
+		w.scaleY = parent.scaleY * local.scaleY;
+		return w;
+	}
+
+	Transform2D TransformHierarchy2D::relativeTo(const WorldTransform2D& parent, const WorldTransform2D& world) {
+		const float c = std::cos(parent.rotation);
+		const float s = std::sin(parent.rotation);
+
+		const float dx = world.posX - parent.posX;
+		const float dy = world.posY - parent.posY;
+
+		// zero parent scale can't be inverted: keep the child's scale as is
+		const float sx = (parent.scaleX != 0.0f) ? parent.scaleX : 1.0f;
+		const float sy = (parent.scaleY != 0.0f) ? parent.scaleY : 1.0f;
+
+		Transform2D t;
+		t.posX = (dx * c + dy * s) / sx;
+		t.posY = (-dx * s + dy * c) / sy;
+		t.rotation = world.rotation - parent.rotation;
+		t.scaleX = world.scaleX / sx;
+		t.scaleY = world.scaleY / sy;
+		return t;
+	}
+
+	WorldTransform2D TransformHierarchy2D::worldOf(const HBE::ECS::Registry& reg, HBE::ECS::Entity e) {
+		if (reg.has<WorldTransform2D>(e)) return reg.get<WorldTransform2D>(e);
+		if (reg.has<Transform2D>(e)) return toWorld(reg.get<Transform2D>(e));
+		return WorldTransform2D{};
+	}
+
+	void TransformHierarchy2D::reset() {
+		m_nodes.clear();
+		m_valid = false;
+		m_updatedLastPass = 0;
+	}
+
+	void TransformHierarchy2D::rebuild(HBE::ECS::Registry& reg) {
+		m_nodes.clear();
+
+		// roots: have children, no parent
+		reg.view<HBE::ECS::Children>().each([&](HBE::ECS::Entity e, HBE::ECS::Children&) {
+			if (reg.has<HBE::ECS::Parent>(e)) return;
+
+			Node n;
+			n.entity = e;
+			m_nodes.push_back(n);
+			});
+
+		// breadth-first: children are appended after every node of the previous depth
+		for (std::size_t i = 0; i < m_nodes.size(); ++i) {
+			const HBE::ECS::Entity e = m_nodes[i].entity;
+			if (!reg.has<HBE::ECS::Children>(e)) continue;
+
+			for (HBE::ECS::Entity child : reg.get<HBE::ECS::Children>(e).entities) {
+				if (!reg.valid(child) || !reg.has<WorldTransform2D>(child)) continue;
+
+				Node n;
+				n.entity = child;
+				n.parent = static_cast<int>(i);
+				m_nodes.push_back(n);
+			}
+		}
+	}
+
+	void TransformHierarchy2D::propagate(HBE::ECS::Registry& reg) {
+		const std::uint64_t version = reg.storageVersion<HBE::ECS::Parent>();
+		const bool force = !m_valid || version != m_parentVersion;
+
+		if (force) {
+			rebuild(reg);
+			m_parentVersion = version;
+			m_valid = true;
+		}
+
+		std::size_t updated = 0;
+
+		for (Node& n : m_nodes) {
+			const Transform2D local = reg.has<Transform2D>(n.entity) ? reg.get<Transform2D>(n.entity) : Transform2D{};
+			const bool parentChanged = (n.parent >= 0) && m_nodes[n.parent].changed;
+
+			n.changed = force || parentChanged || !sameTransform(local, n.local);
+			if (!n.changed) continue;
+
+			n.local = local;
+			if (n.parent >= 0) {
+				n.world = compose(m_nodes[n.parent].world, local);
+				reg.get<WorldTransform2D>(n.entity) = n.world;
+			}
+			else {
+				n.world = toWorld(local);
+			}
+			++updated;
+		}
+
+		m_updatedLastPass = updated;
+	}
+
+}
@@ -15,6 +15,8 @@
 #include "HBE/Renderer/TileCollision.h"
 #include "HBE/Renderer/TextRenderer2D.h"
 #include "HBE/Renderer/UI/UIContext.h"
+#include "HBE/ECS/SnapshotRing.h"
+#include "HBE/ECS/Prefab.h"
 
 #include <vector>
 #include <string>
@@ -24,6 +26,7 @@ namespace HBE::Core { class Application; }
 class GameLayer final : public HBE::Core::Layer {
 public:
 	void onAttach(HBE::Core::Application& app) override;
+	void onFixedUpdate(float dt) override;
 	void onUpdate(float dt) override;
 	void onRender() override;
 
@@ -109,6 +112,22 @@ private:
 	bool m_drawAllColliders = true;
 	bool m_enableCulling = true;
 
+	// rollback / instant replay (console: snap_rec, rewind)
+	HBE::ECS::SnapshotRing m_snapshots{ 120 };
+	std::uint64_t m_simFrame = 0;
+	bool m_recordSnapshots = false;
+
+	// edge-triggered input for scripts: latched each frame, cleared by the fixed step that sees it
+	struct LatchedInput {
+		bool jump = false;
+		bool attack = false;
+		bool confirm = false;
+	};
+	LatchedInput m_latchedInput{};
+
+	// bulk spawning (console: spawn_wave)
+	HBE::ECS::Prefab m_goblinPrefab{};
+
 	// FPS graph history
 	std::vector<float> m_fpsHistory;
 	int m_fpsHistoryMax = 120;
@@ -3,6 +3,7 @@
 
 #include "HBE/Core/Application.h"
 #include "HBE/Core/Log.h"
+#include "HBE/Core/Time.h"
 #include "HBE/Core/Event.h"
 
 #include "HBE/Platform/Input.h"
@@ -54,6 +55,7 @@ namespace {
 
     // Scene serialization file (relative to HBE.Sandbox CWD)
     constexpr const char* SCENE_PATH = "assets/scenes/sandbox.scene.json";
+    constexpr const char* GOBLIN_PREFAB_PATH = "assets/prefabs/goblin.prefab.json";
 
     static float Approach(float v, float target, float maxDelta) {
         if (v < target) return std::min(v + maxDelta, target);
@@ -195,15 +197,17 @@ void GameLayer::onAttach(Application& app) {
     // Hook Scene2D physics/collision to this tilemap layer
     m_scene.setTileCollisionContext(&m_tileMap, m_collisionLayer);
 
-    // Physics-lite tuning (gravity + substeps)
+    // Physics-lite tuning
     {
         HBE::Renderer::Physics2DSettings phys{};
         phys.gravityY = -1800.0f;         // world units / s^2 (negative = down)
-        phys.maxSubSteps = 4;             // stability
-        phys.maxStepDt = 1.0f / 120.0f;   // stability
+        phys.maxSubSteps = 0;             // the 60 Hz fixed step is one integration step
         m_scene.setPhysics2DSettings(phys);
     }
 
+    // Simulation runs at a fixed rate, rendering interpolates between steps
+    app.setFixedUpdateRate(60.0f, 5);
+
     // -------------------------
     // Dev Console commands
     // -------------------------
@@ -219,6 +223,11 @@ void GameLayer::onAttach(Application& app) {
         m_console.print("  tp <x> <y>       (teleport player/soldier)");
         m_console.print("  reload_ui");
         m_console.print("  reload_shader");
+        m_console.print("  ecs_mem          (per-component storage memory)");
+        m_console.print("  snap_rec [0/1]   (record registry snapshots every frame)");
+        m_console.print("  rewind <frames>  (restore a recorded frame)");
+        m_console.print("  spawn_wave <n>   (instantiate n goblin prefabs)");
+        m_console.print("  systems [0/1]    (system timings; 0 = run sequentially)");
         });
 
     m_console.registerCommand("clear", "Clear console output", [this](const std::vector<std::string>&) {
@@ -244,6 +253,20 @@ void GameLayer::onAttach(Application& app) {
         m_console.print(std::string("colliders set to ") + (m_debugDraw ? "1" : "0"));
         });
 
+    m_console.registerCommand("tickrate", "tickrate <hz> - fixed simulation rate", [this](const std::vector<std::string>& args) {
+        if (args.size() < 1) {
+            m_console.print("Usage: tickrate <hz>");
+            return;
+        }
+        const float hz = std::stof(args[0]);
+        if (hz <= 0.0f) {
+            m_console.print("tickrate must be > 0");
+            return;
+        }
+        m_app->setFixedUpdateRate(hz, 5);
+        m_console.print("tickrate set.");
+        });
+
     m_console.registerCommand("gravity", "gravity <value> - set physics gravityY", [this](const std::vector<std::string>& args) {
         if (args.size() < 1) {
             m_console.print("Usage: gravity <value>");
@@ -276,6 +299,111 @@ void GameLayer::onAttach(Application& app) {
         }
         });
 
+    m_console.registerCommand("ecs_mem", "Print per-component ECS storage memory", [this](const std::vector<std::string>&) {
+        std::size_t total = 0;
+        for (const auto& st : m_scene.registry().memoryReport()) {
+            total += st.totalBytes();
+            m_console.print(std::string(st.typeName) + ": " + std::to_string(st.count) + " comps, " +
+                std::to_string(st.totalBytes() / 1024) + " KB (sparse " + std::to_string(st.sparseBytes / 1024) +
+                " KB, " + std::to_string(st.sparsePages) + " pages)");
+        }
+        m_console.print("Total: " + std::to_string(total / 1024) + " KB");
+        });
+
+    m_console.registerCommand("snap_rec", "snap_rec [0/1] - record a registry snapshot every frame", [this](const std::vector<std::string>& args) {
+        if (!args.empty()) {
+            m_recordSnapshots = (args[0] != "0");
+            if (!m_recordSnapshots) m_snapshots.clear();
+        }
+
+        const auto& st = m_snapshots.stats();
+        m_console.print(std::string("snap_rec = ") + (m_recordSnapshots ? "1" : "0") + ", " +
+            std::to_string(st.framesHeld) + "/" + std::to_string(m_snapshots.capacity()) + " frames, " +
+            std::to_string(st.lastBytes / 1024) + " KB/frame, capture " + std::to_string(st.lastCaptureMicros) + " us");
+        });
+
+    m_console.registerCommand("rewind", "rewind <frames> - restore the registry to a recorded frame", [this](const std::vector<std::string>& args) {
+        if (args.size() < 1) {
+            m_console.print("Usage: rewind <frames>");
+            return;
+        }
+
+        const std::uint64_t back = static_cast<std::uint64_t>(std::max(0, std::stoi(args[0])));
+        if (m_simFrame == 0 || back >= m_simFrame) {
+            m_console.print("Nothing recorded that far back.");
+            return;
+        }
+
+        const std::uint64_t target = m_simFrame - 1 - back;
+        if (!m_snapshots.restore(m_scene.registry(), target)) {
+            m_console.print("Frame not in the snapshot ring (snap_rec 1 first).");
+            return;
+        }
+
+        m_snapshots.discardAfter(target);
+        m_simFrame = target + 1;
+        m_console.print("Rewound " + std::to_string(back) + " frames (" +
+            std::to_string(m_snapshots.stats().lastRestoreMicros) + " us)");
+        });
+
+    m_console.registerCommand("spawn_wave", "spawn_wave <count> - spawn goblins from the prefab around the player", [this](const std::vector<std::string>& args) {
+        const int count = args.empty() ? 100 : std::max(0, std::stoi(args[0]));
+
+        if (m_goblinPrefab.empty()) {
+            HBE::Renderer::SceneLoadCallbacks cb{};
+            cb.mesh = [this](const std::string& key) -> HBE::Renderer::Mesh* {
+                return (key == "quad") ? m_quadMesh : nullptr;
+                };
+            cb.material = [this](const std::string& key) -> HBE::Renderer::Material* {
+                return (key == "goblin_mat") ? &m_goblinMaterial : nullptr;
+                };
+
+            std::string err;
+            if (!HBE::Renderer::SceneSerializer::loadPrefabFromFile(m_goblinPrefab, GOBLIN_PREFAB_PATH, cb, &err)) {
+                m_console.print("Prefab load failed: " + err);
+                return;
+            }
+        }
+
+        const Transform2D* playerTr = m_scene.getTransform(m_soldierEntity);
+        const float cx = playerTr ? playerTr->posX : m_camera.x;
+        const float cy = playerTr ? playerTr->posY : m_camera.y;
+
+        auto& reg = m_scene.registry();
+        std::vector<HBE::ECS::Entity> spawned;
+        spawned.reserve(count);
+
+        const double t0 = HBE::Core::GetTimeSeconds();
+        reg.instantiate(m_goblinPrefab, static_cast<std::size_t>(count), spawned);
+        const double spawnMs = (HBE::Core::GetTimeSeconds() - t0) * 1000.0;
+
+        // spread them over a few rows above the player
+        const int perRow = 64;
+        for (std::size_t i = 0; i < spawned.size(); ++i) {
+            auto& tr = reg.get<Transform2D>(spawned[i]);
+            tr.posX = cx + (static_cast<float>(i % perRow) - perRow * 0.5f) * 24.0f;
+            tr.posY = cy + 200.0f + static_cast<float>(i / perRow) * 32.0f;
+        }
+
+        m_console.print("Spawned " + std::to_string(spawned.size()) + " in " + std::to_string(spawnMs) + " ms");
+        });
+
+    m_console.registerCommand("systems", "systems [0/1] - print scene system timings, toggle parallel scheduling", [this](const std::vector<std::string>& args) {
+        auto& sched = m_scene.systems();
+        if (!args.empty()) {
+            sched.setParallel(args[0] != "0");
+        }
+
+        const auto& st = sched.stats();
+        m_console.print(std::string("parallel = ") + (sched.parallel() ? "1" : "0") + ", " + std::to_string(st.waveCount) + " waves");
+        for (const auto& t : st.systems) {
+            m_console.print("  " + t.name + " [wave " + std::to_string(t.wave) + "] " + std::to_string(t.micros) + " us" +
+                (t.onCriticalPath ? " *" : ""));
+        }
+        m_console.print("frame " + std::to_string(st.totalMicros) + " us, serial " + std::to_string(st.serialMicros) +
+            " us, critical path (*) " + std::to_string(st.criticalPathMicros) + " us");
+        });
+
     m_console.registerCommand("reload_ui", "Hot reload UI theme", [this](const std::vector<std::string>&) {
         hotReloadUITheme();
         m_console.print("UI theme reloaded.");
@@ -357,8 +485,8 @@ void GameLayer::onAttach(Application& app) {
             const float inputY = HBE::Input::AxisValue(HBE::Input::Axis::MoveY);
 
             const bool Down = (inputY > 0.5f);
-            const bool JumpPressed = HBE::Input::ActionPressed(HBE::Input::Action::Jump);
-            const bool AttackPressed = HBE::Input::ActionPressed(HBE::Input::Action::Attack);
+            const bool JumpPressed = m_latchedInput.jump;
+            const bool AttackPressed = m_latchedInput.attack;
 
             // -------- TUNING --------
             const float moveSpeed = 520.0f;
@@ -430,7 +558,7 @@ void GameLayer::onAttach(Application& app) {
             (void)dt;
             if (auto* gAnim = m_scene.getSpriteAnimator(e)) {
                 gAnim->setBool("moving", false);
-                if (HBE::Input::ActionPressed(HBE::Input::Action::UIConfirm)) {
+                if (m_latchedInput.confirm) {
                     gAnim->trigger("attack");
                 }
             }
@@ -747,8 +875,8 @@ void GameLayer::onUpdate(float dt) {
                     const float inputY = HBE::Input::AxisValue(HBE::Input::Axis::MoveY);
 
                     const bool Down = (inputY > 0.5f);
-                    const bool JumpPressed = HBE::Input::ActionPressed(HBE::Input::Action::Jump);
-                    const bool AttackPressed = HBE::Input::ActionPressed(HBE::Input::Action::Attack);
+                    const bool JumpPressed = m_latchedInput.jump;
+                    const bool AttackPressed = m_latchedInput.attack;
 
                     const float moveSpeed = 520.0f;
                     const float accelGround = 5200.0f;
@@ -791,7 +919,7 @@ void GameLayer::onUpdate(float dt) {
                     (void)dt;
                     if (auto* gAnim = m_scene.getSpriteAnimator(ent)) {
                         gAnim->setBool("moving", false);
-                        if (HBE::Input::ActionPressed(HBE::Input::Action::UIConfirm)) {
+                        if (m_latchedInput.confirm) {
                             gAnim->trigger("attack");
                         }
                     }
@@ -868,11 +996,10 @@ void GameLayer::onUpdate(float dt) {
             m_goblinEntity = {};
 
             auto& reg = m_scene.registry();
-            for (auto ent : reg.view<HBE::ECS::TagComponent>()) {
-                const auto& tag = reg.get<HBE::ECS::TagComponent>(ent).tag;
-                if (tag == "Player")  m_soldierEntity = ent;
-                if (tag == "Goblin")  m_goblinEntity = ent;
-            }
+            reg.view<HBE::ECS::TagComponent>().each([&](HBE::ECS::Entity ent, const HBE::ECS::TagComponent& tc) {
+                if (tc.tag == "Player")  m_soldierEntity = ent;
+                if (tc.tag == "Goblin")  m_goblinEntity = ent;
+                });
         }
 
         // FPS history (instant)
@@ -886,9 +1013,37 @@ void GameLayer::onUpdate(float dt) {
     // Hot reload poll
     m_watcher.poll(dt);
 
+    // Scripts run in fixed steps: hold presses until the next step consumes them
+    m_latchedInput.jump |= HBE::Input::ActionPressed(HBE::Input::Action::Jump);
+    m_latchedInput.attack |= HBE::Input::ActionPressed(HBE::Input::Action::Attack);
+    m_latchedInput.confirm |= HBE::Input::ActionPressed(HBE::Input::Action::UIConfirm);
+
     // Controlled entity (for camera follow)
-    Transform2D* playerTr = m_scene.getTransform(m_soldierEntity);
-    if (!playerTr) return;
+    if (!m_scene.getTransform(m_soldierEntity)) return;
+
+    // camera follows the interpolated player so it doesn't judder against the sprites
+    m_scene.setRenderAlpha(m_app->fixedAlpha());
+    const Transform2D playerTr = m_scene.renderTransform(m_soldierEntity);
+    m_camera.x = playerTr.posX;
+    m_camera.y = playerTr.posY;
+    m_app->gl().setCamera(m_camera);
+
+    // debug popup aging / movement
+    for (auto& p : m_popups) {
+        p.life -= dt;
+        p.y += p.floatSpeed * dt;
+    }
+
+    // remove dead
+    m_popups.erase(
+        std::remove_if(m_popups.begin(), m_popups.end(),
+            [](const DebugPopup& p) { return p.life <= 0.0f; }),
+        m_popups.end()
+    );
+}
+
+void GameLayer::onFixedUpdate(float dt) {
+    if (!m_scene.getTransform(m_soldierEntity)) return;
 
     // Tick scripts + physics + animators.
     // Catch animation events here.
@@ -905,23 +1060,12 @@ void GameLayer::onUpdate(float dt) {
         }
         });
 
-    // camera follow
-    m_camera.x = playerTr->posX;
-    m_camera.y = playerTr->posY;
-    m_app->gl().setCamera(m_camera);
-
-    // debug popup aging / movement
-    for (auto& p : m_popups) {
-        p.life -= dt;
-        p.y += p.floatSpeed * dt;
+    if (m_recordSnapshots) {
+        m_snapshots.capture(m_scene.registry(), m_simFrame);
     }
+    ++m_simFrame;
 
-    // remove dead
-    m_popups.erase(
-        std::remove_if(m_popups.begin(), m_popups.end(),
-            [](const DebugPopup& p) { return p.life <= 0.0f; }),
-        m_popups.end()
-    );
+    m_latchedInput = {};
 }
 
 void GameLayer::onRender() {
@@ -976,10 +1120,7 @@ void GameLayer::onRender() {
         auto& reg = m_scene.registry();
 
         if (m_drawAllColliders) {
-            for (auto e : reg.view<HBE::Renderer::Transform2D, HBE::ECS::Collider2D>()) {
-                auto& tr = reg.get<HBE::Renderer::Transform2D>(e);
-                auto& col = reg.get<HBE::ECS::Collider2D>(e);
-
+            for (auto [e, tr, col] : reg.view<HBE::Renderer::Transform2D, HBE::ECS::Collider2D>().each()) {
                 float cx = tr.posX + col.offsetX;
                 float cy = tr.posY + col.offsetY;
                 float w = col.halfW * 2.0f;
@@ -1154,12 +1295,15 @@ void GameLayer::onRender() {
                 auto& tr = reg.get<HBE::Renderer::Transform2D>(m_selectedEntity);
                 m_ui.label("Transform", true);
 
-                m_ui.sliderFloat("tr_x", "posX", tr.posX, -5000.0f, 5000.0f, 1.0f);
-                m_ui.sliderFloat("tr_y", "posY", tr.posY, -5000.0f, 5000.0f, 1.0f);
+                // patch on edit so the static collider grid picks up moved statics
+                bool trChanged = false;
+                trChanged |= m_ui.sliderFloat("tr_x", "posX", tr.posX, -5000.0f, 5000.0f, 1.0f);
+                trChanged |= m_ui.sliderFloat("tr_y", "posY", tr.posY, -5000.0f, 5000.0f, 1.0f);
                 constexpr float PI = 3.14159265358979323846f;
-                m_ui.sliderFloat("tr_rot", "rotation (rad)", tr.rotation, -PI, PI, 0.01f);
-                m_ui.sliderFloat("tr_sx", "scaleX", tr.scaleX, 0.1f, 10.0f, 0.1f);
-                m_ui.sliderFloat("tr_sy", "scaleY", tr.scaleY, 0.1f, 10.0f, 0.1f);
+                trChanged |= m_ui.sliderFloat("tr_rot", "rotation (rad)", tr.rotation, -PI, PI, 0.01f);
+                trChanged |= m_ui.sliderFloat("tr_sx", "scaleX", tr.scaleX, 0.1f, 10.0f, 0.1f);
+                trChanged |= m_ui.sliderFloat("tr_sy", "scaleY", tr.scaleY, 0.1f, 10.0f, 0.1f);
+                if (trChanged) reg.patch<HBE::Renderer::Transform2D>(m_selectedEntity);
 
                 m_ui.spacing(6.0f);
             }
@@ -1178,11 +1322,13 @@ void GameLayer::onRender() {
             if (reg.has<HBE::ECS::Collider2D>(m_selectedEntity)) {
                 auto& col = reg.get<HBE::ECS::Collider2D>(m_selectedEntity);
                 m_ui.label("Collider2D", true);
-                m_ui.sliderFloat("col_hw", "halfW", col.halfW, 0.0f, 500.0f, 0.5f);
-                m_ui.sliderFloat("col_hh", "halfH", col.halfH, 0.0f, 500.0f, 0.5f);
-                m_ui.sliderFloat("col_ox", "offsetX", col.offsetX, -200.0f, 200.0f, 0.5f);
-                m_ui.sliderFloat("col_oy", "offsetY", col.offsetY, -200.0f, 200.0f, 0.5f);
-                m_ui.checkbox("col_trig", "isTrigger", col.isTrigger);
+                bool colChanged = false;
+                colChanged |= m_ui.sliderFloat("col_hw", "halfW", col.halfW, 0.0f, 500.0f, 0.5f);
+                colChanged |= m_ui.sliderFloat("col_hh", "halfH", col.halfH, 0.0f, 500.0f, 0.5f);
+                colChanged |= m_ui.sliderFloat("col_ox", "offsetX", col.offsetX, -200.0f, 200.0f, 0.5f);
+                colChanged |= m_ui.sliderFloat("col_oy", "offsetY", col.offsetY, -200.0f, 200.0f, 0.5f);
+                colChanged |= m_ui.checkbox("col_trig", "isTrigger", col.isTrigger);
+                if (colChanged) reg.patch<HBE::ECS::Collider2D>(m_selectedEntity);
                 m_ui.spacing(6.0f);
             }
 
@@ -1190,7 +1336,10 @@ void GameLayer::onRender() {
             if (reg.has<HBE::ECS::RigidBody2D>(m_selectedEntity)) {
                 auto& rb = reg.get<HBE::ECS::RigidBody2D>(m_selectedEntity);
                 m_ui.label("RigidBody2D", true);
-                m_ui.checkbox("rb_static", "isStatic", rb.isStatic);
+                // isStatic changes collision membership; patch so cached collider sets notice
+                if (m_ui.checkbox("rb_static", "isStatic", rb.isStatic)) {
+                    reg.patch<HBE::ECS::RigidBody2D>(m_selectedEntity);
+                }
                 m_ui.checkbox("rb_grav", "useGravity", rb.useGravity);
                 m_ui.sliderFloat("rb_vx", "velX", rb.velX, -4000.0f, 4000.0f, 1.0f);
                 m_ui.sliderFloat("rb_vy", "velY", rb.velY, -4000.0f, 4000.0f, 1.0f);
@@ -1265,6 +1414,24 @@ bool GameLayer::onEvent(HBE::Core::Event& e) {
     m_console.onEvent(e);
     if (e.handled) return true;
 
+    // Right-click in the world selects the collider under the cursor for the Inspector
+    if (e.type() == EventType::MouseButtonPressed && m_showInspector) {
+        auto& mb = static_cast<MouseButtonPressedEvent&>(e);
+        if (mb.button == 3 && mb.inViewport) {
+            const float zoom = (m_camera.zoom > 0.0001f) ? m_camera.zoom : 0.0001f;
+            const float wx = m_camera.x + (mb.logicalX - LOGICAL_WIDTH * 0.5f) / zoom;
+            const float wy = m_camera.y + (mb.logicalY - LOGICAL_HEIGHT * 0.5f) / zoom;
+
+            HBE::Renderer::EntityID hits[8];
+            const std::size_t count = m_scene.queryPoint(wx, wy, hits, 8);
+            if (count > 0) {
+                m_selectedEntity = hits[0];
+                e.handled = true;
+                return true;
+            }
+        }
+    }
+
     if (e.type() == EventType::WindowResize) {
         return false;
     }